@@ -13,6 +13,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "Hardware_PWM.hpp"
+#include <math.h>
 
 /**
   * @brief  Hardware PWM controller Class. Version 1
@@ -20,11 +21,65 @@
 namespace Hardware_PWM_Ver1
 {
 	/* Variables -----------------------------------------------------------------*/
+	/* Timers which are connected to the APB1 bus clock. Other timers are connected to the APB2 bus clock */
+	static TIM_TypeDef* const pxAPB1_Timers[] =
+	{
+#ifdef TIM2
+		TIM2,
+#endif
+#ifdef TIM3
+		TIM3,
+#endif
+#ifdef TIM4
+		TIM4,
+#endif
+#ifdef TIM5
+		TIM5,
+#endif
+#ifdef TIM6
+		TIM6,
+#endif
+#ifdef TIM7
+		TIM7,
+#endif
+#ifdef TIM12
+		TIM12,
+#endif
+#ifdef TIM13
+		TIM13,
+#endif
+#ifdef TIM14
+		TIM14,
+#endif
+#ifdef TIM18
+		TIM18,
+#endif
+		NULL
+	};
+
+	/* Timers which have an 8 bit repetition counter while TIM_RCR_REP is 16 bit (STM32G4, H7, L4 and similar families) */
+	static TIM_TypeDef* const pxRepetition_8bit_Timers[] =
+	{
+#ifdef TIM15
+		TIM15,
+#endif
+#ifdef TIM16
+		TIM16,
+#endif
+#ifdef TIM17
+		TIM17,
+#endif
+		NULL
+	};
+
+	/* Objects which use the update DMA request. The DMA callbacks find their object by the timer handle */
+	static Hardware_PWM* pxDMA_Timers[HARDWARE_PWM_DMA_TIMERS];
+
 	/* Version Control -----------------------------------------------------------*/
 	/* Functions Definitions -----------------------------------------------------*/
 	/**
 	  * @brief  Constructor function
-	  * @param  _pxTimer: The address of timer handle variable
+	  * @param  _pxTimer: The address of timer handle variable. If its Instance is NULL, TIM1 is used
 	  *			_pxUsed_Channels: The address of PWM channel status variable
 	  *			_pxTimerSpecs_Data: All timer specifications. Frequency according to Hz
 	  *														  DeadTime value according to nS
@@ -34,13 +89,105 @@ namespace Hardware_PWM_Ver1
 	{
 		/****************************** Initial Values ******************************/
 		this->pxTimer = _pxTimer;
+		if (this->pxTimer->Instance == NULL)	//The timer is not selected in the handle
+		{
+			this->pxTimer->Instance = TIM1;
+		}
 		this->pxUsed_Channels = _pxUsed_Channels;
 		this->pxTimerSpecs_Data = _pxTimerSpecs_Data;
 		this->ulTimer_Prescaler = 0;
 		this->ulTimer_Period = 0;
+		this->dTimer_Frequency = 0;
+		this->ulTimer_Clock = 0;
+		this->ulTimer_ClockDivision = TIM_CLOCKDIVISION_DIV1;
+		this->ulTimer_DeadTime = 0;
+		this->ulTimer_DeadTime_Clock = 0;
+		this->ulTimer_DeadTime_Clocks = 0;
+		this->ulTimer_TriggerOutput = TIM_TRGO_RESET;
+#if defined(TIM_TRGO2_OC4REF)
+		this->ulTimer_TriggerOutput2 = TIM_TRGO2_RESET;
+#endif
+		this->ulTimer_MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+		this->xTimer_IsSlave = false;
+		this->ulTimer_InputTrigger = 0;
+		this->ulPhase_Stretch = 0;
+		this->ucPhase_Pending = 0;
+		this->ucPhase_Wrap = 0;
+		this->ucDither_Channels = 0;
+		this->ucDither_Order = 1;
+		this->xDither_Interrupt = false;
+		this->xCommand_Enabled = false;
+		this->ucCommand_Record = 0;
+		this->ucCommand_Pending_Frequency = 0;
+		this->xPulse_Running = false;
+		this->xPulse_Interrupt = false;
+		this->xUpdate_Interrupt = false;
+		this->ucPulse_Channel = 0;
+		this->ulPulse_DutyCycle = 0;
+		this->pxPulse_Segments = NULL;
+		this->usPulse_Segment_Count = 0;
+		this->usPulse_Segment = 0;
+		this->ulPulse_Period = 0;
+		this->ulPulse_Left = 0;
+		this->xPulse_Single._ulPeriod = 0;
+		this->xPulse_Single._ulPulses = 0;
+		this->xTrigger_Enabled = false;
+		this->xTrigger._ucChannel = TIM_CHANNEL_3;
+		this->xTrigger._xAnchor = TriggerPosition;
+		this->xTrigger._ucReference = TIM_CHANNEL_1;
+		this->xTrigger._ulPosition = 0;
+		this->xTrigger._lOffset = 0;
+		this->xBreak_Config._ulBreakState = TIM_BREAK_DISABLE;
+		this->xBreak_Config._ulBreakPolarity = TIM_BREAKPOLARITY_HIGH;
+		this->xBreak_Config._ulBreakFilter = 0;
+		this->xBreak_Config._ulBreak2State = 0;
+		this->xBreak_Config._ulBreak2Polarity = 0;
+		this->xBreak_Config._ulBreak2Filter = 0;
+		this->xBreak_Config._ulOffStateRunMode = TIM_OSSR_DISABLE;
+		this->xBreak_Config._ulOffStateIdleMode = TIM_OSSI_DISABLE;
+		this->xBreak_Config._ucIdleStates = 0;
+		this->xBreak_Config._ulLockLevel = TIM_LOCKLEVEL_OFF;
+		this->xBreak_Config._ulAutomaticOutput = TIM_AUTOMATICOUTPUT_DISABLE;
+		this->xBreak_Config._xInterrupt = false;
+		this->xBreak_Fault = false;
+		this->ulBreak_Count = 0;
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			this->ulPhase_Compare[i] = 0;
+			this->ulDither_Target[i] = 0;
+			this->lDither_Error[i][0] = 0;
+			this->lDither_Error[i][1] = 0;
+			this->ulCommand_DutyCycle[i] = 0;
+			this->ucCommand_Pending[i] = 0;
+			this->ulDuty_Ticks[i] = 0;
+			this->ulDuty_Counts[i] = 0;
+			this->ulDuty_Scaled[i] = 0;
+		}
+		this->xDMA_Mode = IdleMode;
+		this->ucUpdate_Depth = 0;
+		this->pulStream_Buffer = NULL;
+		this->usStream_Frames = 0;
+		this->ucStream_Ready = 0;
+		this->ulStream_Underruns = 0;
+		this->pxStream_Callback = NULL;
+		this->pvStream_Context = NULL;
+		this->pulRamp_Frames = NULL;
+		this->usRamp_Frames = 0;
+		this->pxSoftware = NULL;
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+		HARDWARE_PWM_CYCLE_COUNTER_INIT();
+		this->Reset_Statistics();
+#endif
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			this->ulSpread_Compare[i] = 0;
+		}
 
 		this->Timer_Calculator(this->pxTimerSpecs_Data->_ulFrequency);
 		this->Timer_Init();
+		this->Channel_Registers_Init();
+		this->Register_Shadow_Sync();
+		this->ucChannel_Running = 0x0F;	//The outputs can be enabled before, so all channels are stopped
 		this->Stop_All_PWM();
 	}
 
@@ -51,7 +198,14 @@ namespace Hardware_PWM_Ver1
 	  */
 	Hardware_PWM::~Hardware_PWM(void)
 	{
-
+		if (this->xDMA_Mode != IdleMode)	//The DMA callbacks should not find a destroyed object
+		{
+			this->DMA_Burst_Stop();
+		}
+		if (this->pxSoftware != NULL)
+		{
+			this->pxSoftware->pxPWM = NULL;
+		}
 	}
 
 	/**
@@ -62,63 +216,14 @@ namespace Hardware_PWM_Ver1
 	  */
 	void Hardware_PWM::Start_PWM(uint8_t _ucChannel, double _DutyCycle)
 	{
-		switch (_ucChannel)
-		{
-		case TIM_CHANNEL_1:
-			if (this->pxUsed_Channels->Channel1 == SingleMode)	//Check the channel status
-			{
-				this->pxTimer->Instance->CCR1 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-				HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_1);	//Start the PWM channel 1
-			}
-			else if (this->pxUsed_Channels->Channel1 == ComplementMode)
-			{
-				this->pxTimer->Instance->CCR1 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-				HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_1);	//Start the PWM channel 1
-				HAL_TIMEx_PWMN_Start(this->pxTimer, TIM_CHANNEL_1);	//Start the PWMN channel 1
-			}
-			break;
-
-		case TIM_CHANNEL_2:
-			if (this->pxUsed_Channels->Channel2 == SingleMode)	//Check the channel status
-			{
-				this->pxTimer->Instance->CCR2 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-				HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_2);	//Start the PWM channel 2
-			}
-			else if (this->pxUsed_Channels->Channel2 == ComplementMode)
-			{
-				this->pxTimer->Instance->CCR2 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-				HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_2);	//Start the PWM channel 2
-				HAL_TIMEx_PWMN_Start(this->pxTimer, TIM_CHANNEL_2);	//Start the PWMN channel 2
-			}
-			break;
-
-		case TIM_CHANNEL_3:	
-			if (this->pxUsed_Channels->Channel3 == SingleMode)	//Check the channel status
-			{
-				this->pxTimer->Instance->CCR3 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-				HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_3);	//Start the PWM channel 3
-			}
-			else if (this->pxUsed_Channels->Channel3 == ComplementMode)
-			{
-				this->pxTimer->Instance->CCR3 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-				HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_3);	//Start the PWM channel 3
-				HAL_TIMEx_PWMN_Start(this->pxTimer, TIM_CHANNEL_3);	//Start the PWMN channel 3
-			}
-			break;
+		HARDWARE_PWM_PROBE(Probe_Start_PWM);
+		uint8_t Index = _ucChannel >> 2;	//TIM_CHANNEL_x values are 0, 4, 8, 12
 
-		case TIM_CHANNEL_4:
-			if (this->pxUsed_Channels->Channel4 == SingleMode)	//Check the channel status
-			{
-				this->pxTimer->Instance->CCR4 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-				HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_4);	//Start the PWM channel 4
-			}
-			else if (this->pxUsed_Channels->Channel4 == ComplementMode)
-			{
-				this->pxTimer->Instance->CCR4 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-				HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_4);	//Start the PWM channel 4
-				HAL_TIMEx_PWMN_Start(this->pxTimer, TIM_CHANNEL_4);	//Start the PWMN channel 4
-			}
-			break;
+		if (this->Get_Channel_Mode(Index) != Disable)	//Check the channel status
+		{
+			this->Channel_Write_Compare(Index, (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0)));	//Set the Capture Compare Register value
+			this->Channel_Outputs_Enable((uint8_t)(1 << Index));	//Start the PWM (and PWMN) output of channel
+			this->Update_ADC_Trigger();
 		}
 	}
 
@@ -129,160 +234,222 @@ namespace Hardware_PWM_Ver1
 	  */
 	void Hardware_PWM::Stop_PWM(uint8_t _ucChannel)
 	{
-		switch (_ucChannel)
-		{
-		case TIM_CHANNEL_1:
-			if (this->pxUsed_Channels->Channel1 == SingleMode)	//Check the channel status
-			{
-				HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_1);	//Stop the PWM channel 1
-			}
-			else if (this->pxUsed_Channels->Channel1 == ComplementMode)
-			{
-				HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_1);		//Stop the PWM channel 1
-				HAL_TIMEx_PWMN_Stop(this->pxTimer, TIM_CHANNEL_1);	//Stop the PWMN channel 1
-			}
-			break;
-
-		case TIM_CHANNEL_2:
-			if (this->pxUsed_Channels->Channel2 == SingleMode)	//Check the channel status
-			{
-				HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_2);	//Stop the PWM channel 2
-			}
-			else if (this->pxUsed_Channels->Channel2 == ComplementMode)
-			{
-				HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_2);		//Stop the PWM channel 2
-				HAL_TIMEx_PWMN_Stop(this->pxTimer, TIM_CHANNEL_2);	//Stop the PWMN channel 2
-			}
-			break;
+		HARDWARE_PWM_PROBE(Probe_Stop_PWM);
+		this->Channel_Outputs_Disable((uint8_t)(1 << (_ucChannel >> 2)));	//Stop the PWM (and PWMN) output of channel
+	}
 
-		case TIM_CHANNEL_3:
-			if (this->pxUsed_Channels->Channel3 == SingleMode)	//Check the channel status
-			{
-				HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_3);	//Stop the PWM channel 3
-			}
-			else if (this->pxUsed_Channels->Channel3 == ComplementMode)
-			{
-				HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_3);		//Stop the PWM channel 3
-				HAL_TIMEx_PWMN_Stop(this->pxTimer, TIM_CHANNEL_3);	//Stop the PWMN channel 3
-			}
-			break;
+	/**
+	  * @brief  This function starts all PWM channels with a dutycycle value
+	  * @param  DutyCycle: Dutycycle value according to percent.
+	  * @retval None
+	  */
+	void Hardware_PWM::Start_All_PWM(double _DutyCycle)
+	{
+		HARDWARE_PWM_PROBE(Probe_Start_All_PWM);
+		uint32_t Ticks = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));
 
-		case TIM_CHANNEL_4:
-			if (this->pxUsed_Channels->Channel4 == SingleMode)	//Check the channel status
-			{
-				HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_4);	//Stop the PWM channel 4
-			}
-			else if (this->pxUsed_Channels->Channel4 == ComplementMode)
+		this->Begin_Update();	//All channels should be loaded in the same PWM period
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			if (this->Get_Channel_Mode(i) != Disable)	//Check the channel status
 			{
-				HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_4);		//Stop the PWM channel 4
-				HAL_TIMEx_PWMN_Stop(this->pxTimer, TIM_CHANNEL_4);	//Stop the PWMN channel 4
+				this->Channel_Write_Compare(i, Ticks);	//Set the Capture Compare Register value
 			}
-			break;
 		}
+		this->Channel_Outputs_Enable(0x0F);	//All channels are started by one register write
+		this->Update_ADC_Trigger();
+		this->End_Update();
 	}
 
 	/**
-	  * @brief  This function starts all PWM channels with a dutycycle value
-	  * @param  DutyCycle: Dutycycle value according to percent.
+	  * @brief  This function stops all PWM channels
+	  * @param  None
 	  * @retval None
 	  */
-	void Hardware_PWM::Start_All_PWM(double _DutyCycle)
+	void Hardware_PWM::Stop_All_PWM(void)
+	{
+		HARDWARE_PWM_PROBE(Probe_Stop_All_PWM);
+		this->Channel_Outputs_Disable(0x0F);	//All channels are stopped by one register write
+	}
+
+	/**
+	  * @brief  This function writes the Capture Compare Register of a channel if its value is changed. The value is compared
+	  *			with the software copy, so the peripheral bus is not read. The DMA modes write the register directly, so
+	  *			it is always written while the update DMA request is used.
+	  * @param  _ucIndex: The channel index. It can be 0,1,2,3 for channel 1,2,3,4
+	  *			_ulTicks: Capture Compare Register value
+	  * @retval None
+	  */
+	void Hardware_PWM::Channel_Write_Compare(uint8_t _ucIndex, uint32_t _ulTicks)
 	{
-		if (this->pxUsed_Channels->Channel1 == SingleMode)	//Check the channel status
+		if ((this->xDMA_Mode != IdleMode) || (this->ulCompare_Shadow[_ucIndex] != _ulTicks))
 		{
-			this->pxTimer->Instance->CCR1 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-			HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_1);	//Start the PWM channel 1
+			this->Channel_Store_Compare(_ucIndex, _ulTicks);
 		}
-		else if (this->pxUsed_Channels->Channel1 == ComplementMode)
+		else
 		{
-			this->pxTimer->Instance->CCR1 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-			HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_1);	//Start the PWM channel 1
-			HAL_TIMEx_PWMN_Start(this->pxTimer, TIM_CHANNEL_1);	//Start the PWMN channel 1
+			HARDWARE_PWM_COUNT(ulSkipped_Writes, 1);
 		}
+	}
+
+	/**
+	  * @brief  This function enables the outputs of stopped channels. Running channels are skipped.
+	  *			The register backend enables all channels by one write to the Capture Compare Enable Register and does the
+	  *			same as HAL_TIM_PWM_Start and HAL_TIMEx_PWMN_Start. The HAL backend calls them for each channel.
+	  *			The main output is not enabled while a break is latched, and running channels are skipped, so only
+	  *			Break_Recover enables the outputs again after a break.
+	  * @param  _ucChannels: Bit 0 to bit 3 select channel 1,2,3,4
+	  * @retval None
+	  */
+	void Hardware_PWM::Channel_Outputs_Enable(uint8_t _ucChannels)
+	{
+		uint8_t Start = 0;
 
-		if (this->pxUsed_Channels->Channel2 == SingleMode)	//Check the channel status
+		for (uint8_t i = 0; i < 4; i++)
 		{
-			this->pxTimer->Instance->CCR2 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-			HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_2);	//Start the PWM channel 2
+			if (((_ucChannels & (1 << i)) != 0) && (this->Get_Channel_Mode(i) != Disable))
+			{
+				if ((this->ucChannel_Running & (1 << i)) == 0)
+				{
+					Start |= (uint8_t)(1 << i);
+				}
+				if ((HARDWARE_PWM_BACKEND == HARDWARE_PWM_BACKEND_LL) || ((this->ucChannel_Running & (1 << i)) != 0))
+				{
+					HARDWARE_PWM_COUNT(ulSaved_HAL_Calls, (this->Get_Channel_Mode(i) == ComplementMode) ? 2 : 1);
+				}
+			}
 		}
-		else if (this->pxUsed_Channels->Channel2 == ComplementMode)
+		if (Start == 0)	//The channels are running
 		{
-			this->pxTimer->Instance->CCR2 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-			HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_2);	//Start the PWM channel 2
-			HAL_TIMEx_PWMN_Start(this->pxTimer, TIM_CHANNEL_2);	//Start the PWMN channel 2
+			HARDWARE_PWM_COUNT(ulSkipped_Writes, 1);
+			return;
 		}
 
-		if (this->pxUsed_Channels->Channel3 == SingleMode)	//Check the channel status
+#if (HARDWARE_PWM_BACKEND == HARDWARE_PWM_BACKEND_HAL)
+		for (uint8_t i = 0; i < 4; i++)
 		{
-			this->pxTimer->Instance->CCR3 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-			HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_3);	//Start the PWM channel 3
+			if ((Start & (1 << i)) != 0)
+			{
+				HAL_TIM_PWM_Start(this->pxTimer, (uint32_t)i << 2);	//Start the PWM channel
+				if (this->Get_Channel_Mode(i) == ComplementMode)
+				{
+					HAL_TIMEx_PWMN_Start(this->pxTimer, (uint32_t)i << 2);	//Start the PWMN channel
+				}
+			}
 		}
-		else if (this->pxUsed_Channels->Channel3 == ComplementMode)
+		if (IS_TIM_BREAK_INSTANCE(this->pxTimer->Instance) && (this->Get_Break_Status() == true))
 		{
-			this->pxTimer->Instance->CCR3 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-			HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_3);	//Start the PWM channel 3
-			HAL_TIMEx_PWMN_Start(this->pxTimer, TIM_CHANNEL_3);	//Start the PWMN channel 3
+			__HAL_TIM_MOE_DISABLE_UNCONDITIONALLY(this->pxTimer);	//HAL_TIM_PWM_Start enables the main output
 		}
+#else
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
 
-		if (this->pxUsed_Channels->Channel4 == SingleMode)	//Check the channel status
+		Timer->CCER |= this->Channel_Enable_Mask(Start);	//Enable the outputs
+		if (IS_TIM_BREAK_INSTANCE(Timer) && (this->Get_Break_Status() == false))	//A latched break keeps the main output disabled
 		{
-			this->pxTimer->Instance->CCR4 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-			HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_4);	//Start the PWM channel 4
+			Timer->BDTR |= TIM_BDTR_MOE;	//Main output enable
 		}
-		else if (this->pxUsed_Channels->Channel4 == ComplementMode)
+		if (this->xTimer_IsSlave == false)	//A slave counter is started by its master
 		{
-			this->pxTimer->Instance->CCR4 = (uint32_t)(this->ulTimer_Period * (_DutyCycle / 100.0));	//Set the Capture Compare Register value
-			HAL_TIM_PWM_Start(this->pxTimer, TIM_CHANNEL_4);	//Start the PWM channel 4
-			HAL_TIMEx_PWMN_Start(this->pxTimer, TIM_CHANNEL_4);	//Start the PWMN channel 4
+			Timer->CR1 |= TIM_CR1_CEN;	//Enable the counter
 		}
+		this->Channel_HAL_State(Start, true);
+#endif
+		this->ucChannel_Running |= Start;
 	}
 
 	/**
-	  * @brief  This function stops all PWM channels
-	  * @param  None
+	  * @brief  This function disables the outputs of running channels. Stopped channels are skipped.
+	  *			The register backend disables all channels by one write to the Capture Compare Enable Register. When all
+	  *			channels are stopped, the main output and the counter are disabled, the same as HAL_TIM_PWM_Stop. The counter
+	  *			is kept if attached software PWM channels are running.
+	  *			The HAL backend calls HAL_TIM_PWM_Stop and HAL_TIMEx_PWMN_Stop for each channel.
+	  * @param  _ucChannels: Bit 0 to bit 3 select channel 1,2,3,4
 	  * @retval None
 	  */
-	void Hardware_PWM::Stop_All_PWM(void)
+	void Hardware_PWM::Channel_Outputs_Disable(uint8_t _ucChannels)
 	{
-		if (this->pxUsed_Channels->Channel1 == SingleMode)	//Check the channel status
-		{
-			HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_1);	//Stop the PWM channel 1
-		}
-		else if (this->pxUsed_Channels->Channel1 == ComplementMode)
-		{
-			HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_1);		//Stop the PWM channel 1
-			HAL_TIMEx_PWMN_Stop(this->pxTimer, TIM_CHANNEL_1);	//Stop the PWMN channel 1
-		}
+		uint8_t Stop = _ucChannels & this->ucChannel_Running;
 
-		if (this->pxUsed_Channels->Channel2 == SingleMode)	//Check the channel status
+		for (uint8_t i = 0; i < 4; i++)
 		{
-			HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_2);	//Stop the PWM channel 2
+			if (((_ucChannels & (1 << i)) != 0) && (this->Get_Channel_Mode(i) != Disable))
+			{
+				if ((HARDWARE_PWM_BACKEND == HARDWARE_PWM_BACKEND_LL) || ((Stop & (1 << i)) == 0))
+				{
+					HARDWARE_PWM_COUNT(ulSaved_HAL_Calls, (this->Get_Channel_Mode(i) == ComplementMode) ? 2 : 1);
+				}
+			}
 		}
-		else if (this->pxUsed_Channels->Channel2 == ComplementMode)
+		if (Stop == 0)	//The channels are stopped
 		{
-			HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_2);		//Stop the PWM channel 2
-			HAL_TIMEx_PWMN_Stop(this->pxTimer, TIM_CHANNEL_2);	//Stop the PWMN channel 2
+			HARDWARE_PWM_COUNT(ulSkipped_Writes, 1);
+			return;
 		}
 
-		if (this->pxUsed_Channels->Channel3 == SingleMode)	//Check the channel status
+#if (HARDWARE_PWM_BACKEND == HARDWARE_PWM_BACKEND_HAL)
+		for (uint8_t i = 0; i < 4; i++)
 		{
-			HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_3);	//Stop the PWM channel 3
+			if (((Stop & (1 << i)) != 0) && (this->Get_Channel_Mode(i) != Disable))
+			{
+				HAL_TIM_PWM_Stop(this->pxTimer, (uint32_t)i << 2);	//Stop the PWM channel
+				if (this->Get_Channel_Mode(i) == ComplementMode)
+				{
+					HAL_TIMEx_PWMN_Stop(this->pxTimer, (uint32_t)i << 2);	//Stop the PWMN channel
+				}
+			}
 		}
-		else if (this->pxUsed_Channels->Channel3 == ComplementMode)
+		if (this->Software_Is_Running() == true)	//HAL_TIM_PWM_Stop disables the counter of software PWM channels too
 		{
-			HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_3);		//Stop the PWM channel 3
-			HAL_TIMEx_PWMN_Stop(this->pxTimer, TIM_CHANNEL_3);	//Stop the PWMN channel 3
+			this->pxTimer->Instance->CR1 |= TIM_CR1_CEN;
 		}
+#else
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
 
-		if (this->pxUsed_Channels->Channel4 == SingleMode)	//Check the channel status
+		Timer->CCER &= ~this->Channel_Enable_Mask(Stop);	//Disable the outputs
+		if ((Timer->CCER & this->Channel_Enable_Mask(0x0F)) == 0)	//All channels are stopped
 		{
-			HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_4);	//Stop the PWM channel 4
+			if (IS_TIM_BREAK_INSTANCE(Timer))
+			{
+				Timer->BDTR &= ~TIM_BDTR_MOE;
+			}
+			if (this->Software_Is_Running() == false)	//The software PWM channels use the counter
+			{
+				Timer->CR1 &= ~TIM_CR1_CEN;
+			}
 		}
-		else if (this->pxUsed_Channels->Channel4 == ComplementMode)
+		this->Channel_HAL_State(Stop, false);
+#endif
+		this->ucChannel_Running &= (uint8_t)~Stop;
+	}
+
+	/**
+	  * @brief  This function keeps the channel states of timer handle the same as the outputs, so HAL functions can be
+	  *			used with this class. It is only needed for HAL versions with channel states.
+	  * @param  _ucChannels: Bit 0 to bit 3 select channel 1,2,3,4
+	  *			_xBusy: true for started channels and false for stopped channels
+	  * @retval None
+	  */
+	void Hardware_PWM::Channel_HAL_State(uint8_t _ucChannels, bool _xBusy)
+	{
+#if defined(TIM_CHANNEL_STATE_SET)
+		HAL_TIM_ChannelStateTypeDef State = _xBusy ? HAL_TIM_CHANNEL_STATE_BUSY : HAL_TIM_CHANNEL_STATE_READY;
+
+		for (uint8_t i = 0; i < 4; i++)
 		{
-			HAL_TIM_PWM_Stop(this->pxTimer, TIM_CHANNEL_4);		//Stop the PWM channel 4
-			HAL_TIMEx_PWMN_Stop(this->pxTimer, TIM_CHANNEL_4);	//Stop the PWMN channel 4
+			if ((_ucChannels & (1 << i)) != 0)
+			{
+				TIM_CHANNEL_STATE_SET(this->pxTimer, (uint32_t)i << 2, State);
+				if (this->Get_Channel_Mode(i) == ComplementMode)
+				{
+					TIM_CHANNEL_N_STATE_SET(this->pxTimer, (uint32_t)i << 2, State);
+				}
+			}
 		}
+#else
+		(void)_ucChannels;
+		(void)_xBusy;
+#endif
 	}
 
 	/**
@@ -293,314 +460,3407 @@ namespace Hardware_PWM_Ver1
 	  */
 	void Hardware_PWM::Change_DutyCycle(uint8_t _ucChannel, double _DutyCycle)
 	{
+		HARDWARE_PWM_PROBE(Probe_Change_DutyCycle);
 		this->Start_PWM(_ucChannel, _DutyCycle);
 	}
 
 	/**
-	  * @brief  This function changes the PWM frequency.
-	  *			Be carefule, after this function you should start your channels with specific dutycycle.
-	  * @param  _ulNewFrequency: PWM frequency according to Hz
-	  * @retval None
+	  * @brief  This function returns the timer period value (Auto Reload Register value)
+	  * @param  None
+	  * @retval Period value
 	  */
-	void Hardware_PWM::Change_Frequency(uint32_t _ulNewFrequency)
+	uint32_t Hardware_PWM::Get_Period(void)
 	{
-		this->Stop_All_PWM();	//At first, stop all channels
-		this->pxTimerSpecs_Data->_ulFrequency = _ulNewFrequency;		//Save the new timer frequency
-		this->Timer_Calculator(this->pxTimerSpecs_Data->_ulFrequency);	//Choose the best values for timer period and timer prescaler
-		this->Timer_Init();		//Initialize the timer
+		return this->ulTimer_Period;
 	}
 
 	/**
-	  * @brief  This function initializes the timer
-	  * @param  None
+	  * @brief  This function changes the dutycycle of all used channels together.
+	  *			The new values are loaded in the same update event, so all outputs change in the same PWM period.
+	  * @param  _DutyCycles: Dutycycle values of channel 1,2,3,4 according to percent.
 	  * @retval None
 	  */
-	void Hardware_PWM::Timer_Init(void)
+	void Hardware_PWM::Set_All_DutyCycle(const double _DutyCycles[4])
 	{
-		TIM_ClockConfigTypeDef sClockSourceConfig = { 0 };
-		TIM_MasterConfigTypeDef sMasterConfig = { 0 };
-		TIM_OC_InitTypeDef sConfigOC = { 0 };
-		TIM_BreakDeadTimeConfigTypeDef sBreakDeadTimeConfig = { 0 };
+		uint32_t Ticks[4];
 
-		this->pxTimer->Instance = TIM1;
-		this->pxTimer->Init.Prescaler = this->ulTimer_Prescaler;
-		this->pxTimer->Init.CounterMode = TIM_COUNTERMODE_UP;
-		this->pxTimer->Init.Period = this->ulTimer_Period;
-		this->pxTimer->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
-		this->pxTimer->Init.RepetitionCounter = 0;
-		this->pxTimer->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
-		if (HAL_TIM_Base_Init(this->pxTimer) != HAL_OK)
+		for (uint8_t i = 0; i < 4; i++)
 		{
-			Error_Handler();
-		}
-		sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
-		if (HAL_TIM_ConfigClockSource(this->pxTimer, &sClockSourceConfig) != HAL_OK)
-		{
-			Error_Handler();
-		}
-		if (HAL_TIM_PWM_Init(this->pxTimer) != HAL_OK)
-		{
-			Error_Handler();
-		}
-		if (HAL_TIM_OC_Init(this->pxTimer) != HAL_OK)
-		{
-			Error_Handler();
-		}
-		sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
-		sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
-		if (HAL_TIMEx_MasterConfigSynchronization(this->pxTimer, &sMasterConfig) != HAL_OK)
-		{
-			Error_Handler();
-		}
-		sConfigOC.OCMode = TIM_OCMODE_PWM1;
-		sConfigOC.Pulse = 0;
-		sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
-		sConfigOC.OCNPolarity = TIM_OCNPOLARITY_HIGH;
-		sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
-		sConfigOC.OCIdleState = TIM_OCIDLESTATE_RESET;
-		sConfigOC.OCNIdleState = TIM_OCNIDLESTATE_RESET;
-		if (HAL_TIM_PWM_ConfigChannel(this->pxTimer, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
-		{
-			Error_Handler();
+			Ticks[i] = (uint32_t)(this->ulTimer_Period * (_DutyCycles[i] / 100.0));	//Calculate the Capture Compare Register value
 		}
-		if (HAL_TIM_PWM_ConfigChannel(this->pxTimer, &sConfigOC, TIM_CHANNEL_2) != HAL_OK)
+		this->Set_All_DutyCycle_Ticks(Ticks);
+	}
+
+	/**
+	  * @brief  This function changes the dutycycle of all used channels together according to timer ticks.
+	  *			The new values are loaded in the same update event, so all outputs change in the same PWM period.
+	  * @param  _ulTicks: Dutycycle values of channel 1,2,3,4 according to timer ticks
+	  * @retval None
+	  */
+	void Hardware_PWM::Set_All_DutyCycle_Ticks(const uint32_t _ulTicks[4])
+	{
+		this->Begin_Update();
+		if (this->pxUsed_Channels->Channel1 != Disable)	//Check the channel status
 		{
-			Error_Handler();
+			this->Channel_Write_Compare(0, _ulTicks[0]);	//Set the Capture Compare Register value
 		}
-		sConfigOC.OCMode = TIM_OCMODE_TIMING;
-		if (HAL_TIM_OC_ConfigChannel(this->pxTimer, &sConfigOC, TIM_CHANNEL_3) != HAL_OK)
+		if (this->pxUsed_Channels->Channel2 != Disable)
 		{
-			Error_Handler();
+			this->Channel_Write_Compare(1, _ulTicks[1]);
 		}
-		sConfigOC.OCMode = TIM_OCMODE_PWM1;
-		if (HAL_TIM_PWM_ConfigChannel(this->pxTimer, &sConfigOC, TIM_CHANNEL_4) != HAL_OK)
+		if (this->pxUsed_Channels->Channel3 != Disable)
 		{
-			Error_Handler();
+			this->Channel_Write_Compare(2, _ulTicks[2]);
 		}
-		sBreakDeadTimeConfig.OffStateRunMode = TIM_OSSR_DISABLE;
-		sBreakDeadTimeConfig.OffStateIDLEMode = TIM_OSSI_DISABLE;
-		sBreakDeadTimeConfig.LockLevel = TIM_LOCKLEVEL_OFF;
-		sBreakDeadTimeConfig.DeadTime = this->Timer_DeadTime_Calculator();
-		sBreakDeadTimeConfig.BreakState = TIM_BREAK_DISABLE;
-		sBreakDeadTimeConfig.BreakPolarity = TIM_BREAKPOLARITY_HIGH;
-		sBreakDeadTimeConfig.AutomaticOutput = TIM_AUTOMATICOUTPUT_DISABLE;
-		if (HAL_TIMEx_ConfigBreakDeadTime(this->pxTimer, &sBreakDeadTimeConfig) != HAL_OK)
+		if (this->pxUsed_Channels->Channel4 != Disable)
 		{
-			Error_Handler();
+			this->Channel_Write_Compare(3, _ulTicks[3]);
 		}
-		HAL_TIM_MspPostInit(this->pxTimer);
+		this->Update_ADC_Trigger();
+		this->End_Update();
 	}
 
 	/**
-	  * @brief  This function chooses the best value of timer period and timer prescaler according to PWM frequency and timer resolution
-	  * @param  _ulFrequency: The frequency of PWM signal according to Hz
+	  * @brief  This function holds the update event, so the new register values are not loaded until End_Update is called.
+	  *			Use it before several fast path calls which should be applied in the same PWM period.
+	  *			The calls can be nested, for example a Begin_Update/End_Update pair of the update interrupt inside a pair
+	  *			of a task. Only the outermost pair writes the UDIS bit.
+	  * @param  None
 	  * @retval None
 	  */
-	void Hardware_PWM::Timer_Calculator(uint32_t _ulFrequency)
+	void Hardware_PWM::Begin_Update(void)
 	{
-		uint32_t Timer_Clock = this->Timer_Get_Frequency();
-
-		this->ulTimer_Prescaler = 0;			//Set the initial value
-
-		if (_ulFrequency < (Timer_Clock / 10))	//Limit the maximum frequency
+		if (this->ucUpdate_Depth == 0)
 		{
-			if (this->pxTimerSpecs_Data->_xTimerIs32bit == true)	//The entered timer is 32 bit
-			{
-				do
-				{
-					this->ulTimer_Period = Timer_Clock / ((this->ulTimer_Prescaler + 1) * (_ulFrequency));	//Calculate the timer period value
-					this->ulTimer_Prescaler++;				//Increse the prescaler value
-				} while (this->ulTimer_Period > 0xFFFFFFFF);//Check the timer period value
-				this->ulTimer_Prescaler--;	//Because of timer
-				this->ulTimer_Period--;		//Because of timer
-			}
-			else	//The entered timer is 16 bit
-			{
-				do
-				{
-					this->ulTimer_Period = Timer_Clock / ((this->ulTimer_Prescaler + 1) * (_ulFrequency));	//Calculate the timer period value
-					this->ulTimer_Prescaler++;				//Increse the prescaler value
-				} while (this->ulTimer_Period > 0xFFFF);	//Check the timer period value
-				this->ulTimer_Prescaler--;	//Because of timer
-				this->ulTimer_Period--;		//Because of timer
-			}
+			this->pxTimer->Instance->CR1 |= TIM_CR1_UDIS;	//Disable the update event
 		}
+		this->ucUpdate_Depth++;
 	}
 
 	/**
-	  * @brief  This function calculates the deadtime register value according to deadtime (nS)
-	  *			Note: Deadtime registe value sholud not be bigger than timer deadtime register capacitance. It depends on the used timer.
+	  * @brief  This function releases the update event, so all new register values are loaded in the next update event.
+	  *			The update event is released by the End_Update of the outermost Begin_Update.
 	  * @param  None
-	  * @retval Deadtime register value
+	  * @retval None
 	  */
-	uint8_t Hardware_PWM::Timer_DeadTime_Calculator(void)
+	void Hardware_PWM::End_Update(void)
 	{
-		uint32_t DeadTime = 0;
-
-		DeadTime = (uint32_t)((this->Timer_Get_Frequency() / 1e9) * this->pxTimerSpecs_Data->_ulDeadTime);	//Calculate the DeadTime register value
-
-		return DeadTime;
+		if (this->ucUpdate_Depth == 0)	//It is not paired with Begin_Update
+		{
+			return;
+		}
+		this->ucUpdate_Depth--;
+		if (this->ucUpdate_Depth == 0)
+		{
+			this->pxTimer->Instance->CR1 &= ~TIM_CR1_UDIS;	//Enable the update event
+		}
 	}
 
 	/**
-	  * @brief  This function returns the timer frequency value according to microcontroller type
-	  *			Be careful, this function should be completed for different microcontroller types.
-	  *			Before using this function check your microcontroller type here and make sure about its bus clock
-	  * @param  None
-	  * @retval Timer Frequency according to Hz
+	  * @brief  This function starts streaming of Capture Compare Register values by the timer DMA burst.
+	  *			In each update event, one frame (CCR1,CCR2,CCR3,CCR4) is written to the timer. The DMA of timer update
+	  *			request should be configured in circular mode, so the buffer is played as a ring. The half and complete
+	  *			transfer callbacks of the DMA are set by this function, so nothing should be forwarded from the HAL
+	  *			callbacks. The channels should be started by Start_PWM before.
+	  * @param  _pulBuffer: The address of ring buffer. Its size should be 4 * _usFrameCount words
+	  *			_usFrameCount: The number of frames in the ring buffer. It should be an even number
+	  *			_pxCallback: The function which refills a free half of buffer. If it is NULL, use Stream_Get_Free_Half
+	  *						 and Stream_Commit_Half to refill the buffer. Both halves should be filled before start
+	  *			_pvContext: This pointer is passed to _pxCallback
+	  * @retval true if the streaming is started. false if the buffer is NULL, the number of frames is zero or odd,
+	  *			or the update DMA request is used by another mode
 	  */
-	uint32_t Hardware_PWM::Timer_Get_Frequency(void)
+	bool Hardware_PWM::Start_Streaming(uint32_t* _pulBuffer, uint16_t _usFrameCount, Stream_Callback_Type _pxCallback, void* _pvContext)
 	{
-		uint32_t Frequency = 0;
-
-#ifdef STM32F0
-		/*All timers are connected to the APB1 bus clock ==> Max = 48MHz*/
-		if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK1Freq())	//It means APB1 Prescaler = 1
+		if ((_pulBuffer == NULL) || (_usFrameCount == 0) || ((_usFrameCount & 1) != 0) || (this->xDMA_Mode != IdleMode))
 		{
-			Frequency = HAL_RCC_GetPCLK1Freq();
+			return false;
 		}
-		else	//It means APB1 Prescaler != 1
+		this->pulStream_Buffer = _pulBuffer;
+		this->usStream_Frames = _usFrameCount;
+		this->pxStream_Callback = _pxCallback;
+		this->pvStream_Context = _pvContext;
+		this->ulStream_Underruns = 0;
+
+		if (this->pxStream_Callback != NULL)	//Fill both halves before start
 		{
-			Frequency = HAL_RCC_GetPCLK1Freq() * 2;
+			this->pxStream_Callback(this->pulStream_Buffer, this->usStream_Frames, this->pvStream_Context);
 		}
-#endif
+		this->ucStream_Ready = 0x03;
+
+		return this->DMA_Burst_Start(StreamMode, TIM_DMABASE_CCR1, TIM_DMABURSTLENGTH_4TRANSFERS, this->pulStream_Buffer, (uint32_t)this->usStream_Frames * 4);
+	}
+
+	/**
+	  * @brief  This function starts the DMA burst of timer update request and sets the DMA callbacks. The HAL callbacks of
+	  *			the burst call HAL_TIM_PeriodElapsedCallback, which is called by the update interrupt too, so the DMA
+	  *			events are dispatched by DMA_Half_Callback and DMA_Complete_Callback instead. HAL sets its callbacks
+	  *			in the start function, so they are replaced in the same critical section. The mode of DMA is set
+	  *			by its configuration: normal for ramps and circular for streaming and spread spectrum.
+	  * @param  _xMode: The usage of DMA
+	  *			_ulBaseAddress: The first register of burst. It can be TIM_DMABASE_xxx
+	  *			_ulBurstLength: The number of registers in each burst. It can be TIM_DMABURSTLENGTH_xxx
+	  *			_pulBuffer: The address of buffer
+	  *			_ulWords: The number of words in the buffer
+	  * @retval true if the DMA is started
+	  */
+	bool Hardware_PWM::DMA_Burst_Start(DMA_ModeType _xMode, uint32_t _ulBaseAddress, uint32_t _ulBurstLength, uint32_t* _pulBuffer, uint32_t _ulWords)
+	{
+		uint8_t Slot = HARDWARE_PWM_DMA_TIMERS;
+		DMA_HandleTypeDef* DMA = this->pxTimer->hdma[TIM_DMA_ID_UPDATE];
+		HAL_StatusTypeDef Status = HAL_OK;
 
-#ifdef STM32F1
-		if (this->pxTimer->Instance == TIM2 || this->pxTimer->Instance == TIM3 || this->pxTimer->Instance == TIM4) //These timers are connected to the APB1 bus clock ==> Max = 36MHz
+		for (uint8_t i = 0; i < HARDWARE_PWM_DMA_TIMERS; i++)	//Register the object for the DMA callbacks
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK1Freq())	//It means APB1 Prescaler = 1
-			{
-				Frequency = HAL_RCC_GetPCLK1Freq();
-			}
-			else	//It means APB1 Prescaler != 1
+			if ((pxDMA_Timers[i] == this) || ((pxDMA_Timers[i] == NULL) && (Slot == HARDWARE_PWM_DMA_TIMERS)))
 			{
-				Frequency = HAL_RCC_GetPCLK1Freq() * 2;
+				Slot = i;
 			}
 		}
-		else	//These timers are connected to the APB2 bus clock ==> Max = 72MHz
+		if ((DMA == NULL) || (Slot == HARDWARE_PWM_DMA_TIMERS))	//No DMA is linked to the update request or HARDWARE_PWM_DMA_TIMERS is small
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK2Freq())	//It means APB2 Prescaler = 1
-			{
-				Frequency = HAL_RCC_GetPCLK2Freq();
-			}
-			else	//It means APB2 Prescaler != 1
-			{
-				Frequency = HAL_RCC_GetPCLK2Freq() * 2;
-			}
+			Error_Handler();
+			return false;
 		}
-#endif
+		pxDMA_Timers[Slot] = this;
 
-#ifdef STM32F2
-		if (this->pxTimer->Instance == TIM2 || this->pxTimer->Instance == TIM3 || this->pxTimer->Instance == TIM4 ||
-			this->pxTimer->Instance == TIM5 || this->pxTimer->Instance == TIM6 || this->pxTimer->Instance == TIM7 ||
-			this->pxTimer->Instance == TIM12 || this->pxTimer->Instance == TIM13 || this->pxTimer->Instance == TIM14) //These timers are connected to the APB1 bus clock ==> Max = 30MHz
+		this->xDMA_Mode = _xMode;
+		HARDWARE_PWM_ENTER_CRITICAL();	//HAL sets its own callbacks, so no DMA interrupt should be served before they are replaced
+		Status = HAL_TIM_DMABurst_MultiWriteStart(this->pxTimer, _ulBaseAddress, TIM_DMA_UPDATE, _pulBuffer, _ulBurstLength, _ulWords);
+		if (Status == HAL_OK)
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK1Freq())	//It means APB1 Prescaler = 1
-			{
-				Frequency = HAL_RCC_GetPCLK1Freq();
-			}
-			else	//It means APB1 Prescaler != 1
-			{
-				Frequency = HAL_RCC_GetPCLK1Freq() * 2;
-			}
+			DMA->XferHalfCpltCallback = Hardware_PWM::DMA_Half_Callback;
+			DMA->XferCpltCallback = Hardware_PWM::DMA_Complete_Callback;
 		}
-		else	//These timers are connected to the APB2 bus clock ==> Max = 60MHz
+		HARDWARE_PWM_EXIT_CRITICAL();
+		if (Status != HAL_OK)
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK2Freq())	//It means APB2 Prescaler = 1
-			{
-				Frequency = HAL_RCC_GetPCLK2Freq();
+			this->xDMA_Mode = IdleMode;
+			pxDMA_Timers[Slot] = NULL;
+			Error_Handler();
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	  * @brief  This function stops the DMA burst of timer update request and removes the object from the DMA callbacks
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::DMA_Burst_Stop(void)
+	{
+		HAL_TIM_DMABurst_WriteStop(this->pxTimer, TIM_DMA_UPDATE);
+		this->xDMA_Mode = IdleMode;
+		this->Register_Shadow_Sync();	//The registers are written by the DMA
+		for (uint8_t i = 0; i < HARDWARE_PWM_DMA_TIMERS; i++)
+		{
+			if (pxDMA_Timers[i] == this)
+			{
+				pxDMA_Timers[i] = NULL;
+			}
+		}
+	}
+
+	/**
+	  * @brief  This function finds the object of a DMA handle which is started by DMA_Burst_Start
+	  * @param  _pxDMA: The DMA handle of timer update request
+	  * @retval The address of object or NULL
+	  */
+	Hardware_PWM* Hardware_PWM::DMA_Find(DMA_HandleTypeDef* _pxDMA)
+	{
+		for (uint8_t i = 0; i < HARDWARE_PWM_DMA_TIMERS; i++)
+		{
+			if ((pxDMA_Timers[i] != NULL) && (pxDMA_Timers[i]->pxTimer == (TIM_HandleTypeDef*)_pxDMA->Parent))
+			{
+				return pxDMA_Timers[i];
+			}
+		}
+		return NULL;
+	}
+
+	/**
+	  * @brief  This function is the half transfer callback of the update DMA request. It is called by HAL_DMA_IRQHandler
+	  * @param  _pxDMA: The DMA handle of timer update request
+	  * @retval None
+	  */
+	void Hardware_PWM::DMA_Half_Callback(DMA_HandleTypeDef* _pxDMA)
+	{
+		Hardware_PWM* PWM = Hardware_PWM::DMA_Find(_pxDMA);
+
+		if (PWM != NULL)
+		{
+			PWM->DMA_HalfTransfer_Handler();
+		}
+	}
+
+	/**
+	  * @brief  This function is the transfer complete callback of the update DMA request. It is called by HAL_DMA_IRQHandler
+	  * @param  _pxDMA: The DMA handle of timer update request
+	  * @retval None
+	  */
+	void Hardware_PWM::DMA_Complete_Callback(DMA_HandleTypeDef* _pxDMA)
+	{
+		Hardware_PWM* PWM = Hardware_PWM::DMA_Find(_pxDMA);
+
+		if (PWM != NULL)
+		{
+			PWM->DMA_TransferComplete_Handler();
+		}
+	}
+
+	/**
+	  * @brief  This function fills a table for spread spectrum mode. The PWM frequency is modulated around the current
+	  *			frequency and the Capture Compare Registers are scaled by each period, so the dutycycles are kept.
+	  *			Each frame is ARR, RCR, CCR1, CCR2, CCR3, CCR4. Build the table after the channels are started.
+	  * @param  _pulFrames: The address of table. Its size should be 6 * _usFrameCount words
+	  *			_usFrameCount: The number of frames (PWM periods) in one modulation period
+	  *			_xProfile: The modulation profile
+	  *			_SpreadPercent: The maximum frequency deviation according to percent
+	  * @retval None
+	  */
+	void Hardware_PWM::Spread_Spectrum_Build(uint32_t* _pulFrames, uint16_t _usFrameCount, Spread_ProfileType _xProfile, double _SpreadPercent)
+	{
+		uint64_t Counts = this->Timer_Counts();
+		uint64_t Capacity = (this->pxTimerSpecs_Data->_xTimerIs32bit == true) ? 0xFFFFFFFFULL : 0xFFFFULL;
+		uint64_t Frame_Counts = 0;
+		uint16_t Random = 0xACE1;	//Seed of the pseudo random generator
+		double Deviation = 0;
+		double Time = 0;
+		bool Center_Aligned = this->Timer_Is_Center_Aligned();
+
+		for (uint16_t n = 0; n < _usFrameCount; n++)
+		{
+			if (_xProfile == TriangleProfile)
+			{
+				Time = (double)n / _usFrameCount;
+				Deviation = (Time < 0.5) ? ((4 * Time) - 1) : (3 - (4 * Time));	//-1 to 1 and back to -1
+			}
+			else
+			{
+				Random = (uint16_t)((Random >> 1) ^ ((Random & 1) ? 0xB400 : 0));	//16 bit Galois LFSR
+				Deviation = (Random / 32768.0) - 1;
+			}
+
+			Frame_Counts = (uint64_t)((Counts * (1 + ((_SpreadPercent / 100.0) * Deviation))) + 0.5);	//A longer period is a lower frequency
+			if (Frame_Counts < 2)
+			{
+				Frame_Counts = 2;
+			}
+			else if (Frame_Counts > Capacity)
+			{
+				Frame_Counts = Capacity;
+			}
+
+			_pulFrames[(n * 6) + 0] = (uint32_t)(Center_Aligned ? Frame_Counts : (Frame_Counts - 1));	//ARR
+			_pulFrames[(n * 6) + 1] = this->pxTimerSpecs_Data->_ulRepetitionCounter;					//RCR
+			for (uint8_t i = 0; i < 4; i++)
+			{
+				_pulFrames[(n * 6) + 2 + i] = (uint32_t)(((uint64_t)this->Channel_Read_Compare(i) * Frame_Counts) / Counts);	//CCRx
+			}
+		}
+	}
+
+	/**
+	  * @brief  This function starts the spread spectrum mode. The table is played by the DMA burst in each update event,
+	  *			so no CPU time is used. The DMA of timer update request should be configured in circular mode.
+	  * @param  _pulFrames: The address of table which is filled by Spread_Spectrum_Build
+	  *			_usFrameCount: The number of frames
+	  * @retval None
+	  */
+	void Hardware_PWM::Start_Spread_Spectrum(uint32_t* _pulFrames, uint16_t _usFrameCount)
+	{
+		for (uint8_t i = 0; i < 4; i++)	//Save the nominal values
+		{
+			this->ulSpread_Compare[i] = this->Channel_Read_Compare(i);
+		}
+		this->pxTimer->Instance->CR1 |= TIM_CR1_ARPE;	//The period is loaded in the update event with the compare values
+		this->DMA_Burst_Start(SpreadSpectrumMode, TIM_DMABASE_ARR, TIM_DMABURSTLENGTH_6TRANSFERS, _pulFrames, (uint32_t)_usFrameCount * 6);
+	}
+
+	/**
+	  * @brief  This function stops the spread spectrum mode and restores the nominal frequency and dutycycles
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Stop_Spread_Spectrum(void)
+	{
+		if (this->xDMA_Mode == SpreadSpectrumMode)
+		{
+			this->DMA_Burst_Stop();
+			this->Begin_Update();
+			this->Timer_Store_Period(this->ulTimer_Period);
+			for (uint8_t i = 0; i < 4; i++)
+			{
+				this->Channel_Store_Compare(i, this->ulSpread_Compare[i]);
+			}
+			this->End_Update();
+		}
+	}
+
+	/**
+	  * @brief  This function fills a ramp table which changes the dutycycle of a channel from its current value to
+	  *			_DutyCycle in _ulTime. Other channels keep their values. See Start_Ramp.
+	  * @param  _pulFrames: The address of table. Its size should be 6 * _usFrameCount words
+	  *			_usFrameCount: The maximum number of frames (steps). More frames make a smoother ramp
+	  *			_ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+	  *			_DutyCycle: Dutycycle value at the end of ramp according to percent.
+	  *			_ulTime: Ramp time according to mS
+	  *			_xShape: The curve of ramp
+	  * @retval The number of frames which are filled. 0 means the timer has no repetition counter or the table is too small
+	  */
+	uint16_t Hardware_PWM::Ramp_Build_DutyCycle(uint32_t* _pulFrames, uint16_t _usFrameCount, uint8_t _ucChannel, double _DutyCycle, uint32_t _ulTime, Ramp_ShapeType _xShape)
+	{
+		return this->Ramp_Build(_pulFrames, _usFrameCount, _ucChannel >> 2, (double)this->Timer_Counts() * (_DutyCycle / 100.0), _ulTime, _xShape);
+	}
+
+	/**
+	  * @brief  This function fills a ramp table which changes the PWM frequency from its current value to _ulNewFrequency
+	  *			in _ulTime. The dutycycles are kept. The prescaler is not changed, so the new period is limited to the timer
+	  *			size at the current prescaler. See Start_Ramp.
+	  * @param  _pulFrames: The address of table. Its size should be 6 * _usFrameCount words
+	  *			_usFrameCount: The maximum number of frames (steps). More frames make a smoother ramp
+	  *			_ulNewFrequency: PWM frequency at the end of ramp according to Hz
+	  *			_ulTime: Ramp time according to mS
+	  *			_xShape: The curve of ramp
+	  * @retval The number of frames which are filled. 0 means the timer has no repetition counter or the table is too small
+	  */
+	uint16_t Hardware_PWM::Ramp_Build_Frequency(uint32_t* _pulFrames, uint16_t _usFrameCount, uint32_t _ulNewFrequency, uint32_t _ulTime, Ramp_ShapeType _xShape)
+	{
+		bool Center_Aligned = this->Timer_Is_Center_Aligned();
+		double Step_Clock = (double)this->Timer_Get_Frequency() / ((double)(this->ulTimer_Prescaler + 1) * (Center_Aligned ? 2 : 1));
+		double Capacity = (this->pxTimerSpecs_Data->_xTimerIs32bit == true) ? 4294967296.0 : 65536.0;	//The number of counts of the timer
+		double Counts = (_ulNewFrequency != 0) ? ((Step_Clock / _ulNewFrequency) + 0.5) : Capacity;
+
+		if (Center_Aligned)		//ARR is the number of counts in each direction
+		{
+			Capacity--;
+		}
+		if (Counts < 2)
+		{
+			Counts = 2;
+		}
+		else if (Counts > Capacity)
+		{
+			Counts = Capacity;
+		}
+		return this->Ramp_Build(_pulFrames, _usFrameCount, 4, (double)(uint64_t)Counts, _ulTime, _xShape);
+	}
+
+	/**
+	  * @brief  This function fills a ramp table. Each frame is ARR, RCR, CCR1, CCR2, CCR3, CCR4, the same as spread
+	  *			spectrum frames. The repetition counter holds each step for several PWM periods, so the DMA request is
+	  *			only made once per step, and the holds are chosen so the whole ramp takes _ulTime. The steps are never
+	  *			shortened, so the table should have enough frames for the longest hold of the repetition counter.
+	  *			The last frame repeats the last step with the repetition counter of TimerSpecs_Type. It is loaded after
+	  *			the last step, so the timer keeps the new values with its own repetition counter.
+	  * @param  _pulFrames: The address of table
+	  *			_usFrameCount: The maximum number of frames
+	  *			_ucIndex: The channel index (0,1,2,3) of a dutycycle ramp, or 4 for a frequency ramp
+	  *			_Target: The Capture Compare Register value or the number of period counts at the end of ramp
+	  *			_ulTime: Ramp time according to mS
+	  *			_xShape: The curve of ramp
+	  * @retval The number of frames which are filled. 0 if the table is too small
+	  */
+	uint16_t Hardware_PWM::Ramp_Build(uint32_t* _pulFrames, uint16_t _usFrameCount, uint8_t _ucIndex, double _Target, uint32_t _ulTime, Ramp_ShapeType _xShape)
+	{
+		bool Center_Aligned = this->Timer_Is_Center_Aligned();
+		double Tick_Time = ((double)(this->ulTimer_Prescaler + 1) * (Center_Aligned ? 2 : 1)) / this->Timer_Get_Frequency();	//The time of one period count according to S
+		double Time = _ulTime / 1000.0;
+		uint64_t Counts = this->Timer_Counts();
+		uint64_t Frame_Counts = Counts;
+		uint32_t Maximum_Hold = Center_Aligned ? ((this->Timer_Repetition_Max() + 1) / 2) : (this->Timer_Repetition_Max() + 1);	//Center aligned modes count two updates in each period
+		uint32_t Compare[4];
+		uint32_t Frames = 0;
+		uint32_t Required = 0;
+		uint32_t Hold = 0;
+		double Start = (_ucIndex < 4) ? (double)this->Channel_Read_Compare(_ucIndex) : (double)Counts;
+		double Longest = (_ucIndex < 4) ? (double)Counts : ((_Target > Counts) ? _Target : (double)Counts);
+		double Shortest = (_ucIndex < 4) ? (double)Counts : ((_Target < Counts) ? _Target : (double)Counts);
+		double Progress = 0;
+		double Shape = 0;
+		double Elapsed = 0;
+
+		if (!IS_TIM_REPETITION_COUNTER_INSTANCE(this->pxTimer->Instance) || (_usFrameCount < 2))
+		{
+			return 0;
+		}
+
+		Required = (uint32_t)ceil(Time / (Shortest * Tick_Time * (Maximum_Hold - 1)));	//One period of each hold is kept for the rounding
+		Frames = (uint32_t)(Time / (Longest * Tick_Time));	//Each step is at least one PWM period
+		if (Frames < Required)
+		{
+			Frames = Required;
+		}
+		if (Frames > ((uint32_t)_usFrameCount - 1))		//The last frame of table is the terminal frame
+		{
+			Frames = (uint32_t)_usFrameCount - 1;
+		}
+		if ((Frames < Required) || (Frames == 0))
+		{
+			return 0;
+		}
+
+		for (uint32_t n = 0; n < Frames; n++)
+		{
+			Progress = (double)(n + 1) / Frames;
+			switch (_xShape)
+			{
+			case SCurveRamp:
+				Shape = Progress * Progress * (3 - (2 * Progress));
+				break;
+			case ExponentialRamp:
+				Shape = (1 - exp(-5 * Progress)) / (1 - exp(-5.0));
+				break;
+			default:
+				Shape = Progress;
+				break;
+			}
+
+			for (uint8_t i = 0; i < 4; i++)
+			{
+				Compare[i] = this->Channel_Read_Compare(i);
+			}
+			if (_ucIndex < 4)
+			{
+				Compare[_ucIndex] = (uint32_t)(Start + ((_Target - Start) * Shape) + 0.5);
+			}
+			else
+			{
+				Frame_Counts = (uint64_t)(Start + ((_Target - Start) * Shape) + 0.5);
+				for (uint8_t i = 0; i < 4; i++)	//Scale the Capture Compare Registers to keep the dutycycles
+				{
+					Compare[i] = (uint32_t)(((uint64_t)Compare[i] * Frame_Counts) / Counts);
+				}
+			}
+			if (this->xTrigger_Enabled == true)
+			{
+				Compare[this->xTrigger._ucChannel >> 2] = this->ADC_Trigger_Point(Frame_Counts, Compare[this->xTrigger._ucReference >> 2]);
+			}
+
+			Hold = (uint32_t)((((Time * Progress) - Elapsed) / (Frame_Counts * Tick_Time)) + 0.5);	//The number of periods of this step
+			if (Hold < 1)
+			{
+				Hold = 1;
+			}
+			else if (Hold > Maximum_Hold)
+			{
+				Hold = Maximum_Hold;
+			}
+			Elapsed += Hold * Frame_Counts * Tick_Time;
+
+			_pulFrames[(n * 6) + 0] = (uint32_t)(Center_Aligned ? Frame_Counts : (Frame_Counts - 1));	//ARR
+			_pulFrames[(n * 6) + 1] = Center_Aligned ? ((2 * Hold) - 1) : (Hold - 1);				//RCR
+			for (uint8_t i = 0; i < 4; i++)
+			{
+				_pulFrames[(n * 6) + 2 + i] = Compare[i];	//CCRx
+			}
+		}
+
+		for (uint8_t i = 0; i < 6; i++)		//The terminal frame restores the repetition counter after the last step
+		{
+			_pulFrames[(Frames * 6) + i] = _pulFrames[((Frames - 1) * 6) + i];
+		}
+		_pulFrames[(Frames * 6) + 1] = this->pxTimerSpecs_Data->_ulRepetitionCounter;
+		return (uint16_t)(Frames + 1);
+	}
+
+	/**
+	  * @brief  This function starts a ramp. The table is played by the DMA burst in the update events, so the CPU is only
+	  *			used at the start and in the transfer complete callback of DMA at the end. After the ramp, the last frame stays and the
+	  *			frequency functions use its period. The channels should be started before. The DMA of timer update request
+	  *			should be configured in normal mode, so the table is played once, while streaming and spread spectrum use
+	  *			circular mode.
+	  * @param  _pulFrames: The address of table which is filled by Ramp_Build_DutyCycle or Ramp_Build_Frequency
+	  *			_usFrameCount: The number of frames which is returned by the build function
+	  * @retval true if the ramp is started
+	  */
+	bool Hardware_PWM::Start_Ramp(uint32_t* _pulFrames, uint16_t _usFrameCount)
+	{
+		if ((this->xDMA_Mode != IdleMode) || (_usFrameCount == 0))
+		{
+			return false;
+		}
+		this->pulRamp_Frames = _pulFrames;
+		this->usRamp_Frames = _usFrameCount;
+		this->pxTimer->Instance->CR1 |= TIM_CR1_ARPE;	//The period is loaded in the update event with the compare values
+		return this->DMA_Burst_Start(RampMode, TIM_DMABASE_ARR, TIM_DMABURSTLENGTH_6TRANSFERS, _pulFrames, (uint32_t)_usFrameCount * 6);
+	}
+
+	/**
+	  * @brief  This function stops a ramp before its end. The last written frame stays, and the repetition counter of
+	  *			TimerSpecs_Type is loaded after its hold
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Stop_Ramp(void)
+	{
+		if (this->xDMA_Mode == RampMode)
+		{
+			this->Ramp_Finish(this->pxTimer->Instance->ARR);
+			this->pxTimer->Instance->RCR = this->pxTimerSpecs_Data->_ulRepetitionCounter;	//No terminal frame is written
+		}
+	}
+
+	/**
+	  * @brief  This function checks the ramp
+	  * @param  None
+	  * @retval true until the last frame is written
+	  */
+	bool Hardware_PWM::Ramp_Is_Running(void)
+	{
+		return (this->xDMA_Mode == RampMode);
+	}
+
+	/**
+	  * @brief  This function stops the DMA of a ramp and saves the new period. The repetition counter is restored by the
+	  *			terminal frame of table, so the hold of the last step is not cut
+	  * @param  _ulPeriod: The Auto Reload Register value of the last frame
+	  * @retval None
+	  */
+	void Hardware_PWM::Ramp_Finish(uint32_t _ulPeriod)
+	{
+		this->DMA_Burst_Stop();
+		this->ulTimer_Period = _ulPeriod;
+		this->pxTimer->Init.Period = _ulPeriod;
+		this->Timer_Update_Frequency();
+		this->pxTimerSpecs_Data->_ulFrequency = (uint32_t)(this->dTimer_Frequency + 0.5);
+	}
+
+	/**
+	  * @brief  This function stops streaming. The last written values stay in the Capture Compare Registers
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Stop_Streaming(void)
+	{
+		if (this->xDMA_Mode == StreamMode)
+		{
+			this->DMA_Burst_Stop();
+		}
+	}
+
+	/**
+	  * @brief  This function returns the half of ring buffer which is played and should be refilled
+	  * @param  None
+	  * @retval The address of free half or NULL if both halves are filled
+	  */
+	uint32_t* Hardware_PWM::Stream_Get_Free_Half(void)
+	{
+		uint8_t Ready = this->ucStream_Ready;
+
+		if ((Ready & 0x01) == 0)
+		{
+			return this->pulStream_Buffer;
+		}
+		if ((Ready & 0x02) == 0)
+		{
+			return this->pulStream_Buffer + ((uint32_t)this->usStream_Frames / 2) * 4;
+		}
+		return NULL;
+	}
+
+	/**
+	  * @brief  This function marks a half of ring buffer as filled. The ready bits are shared with the DMA interrupt, so
+	  *			they are changed in a critical section.
+	  * @param  _pulHalf: The address which is returned by Stream_Get_Free_Half
+	  * @retval true if _pulHalf is the address of a half of ring buffer
+	  */
+	bool Hardware_PWM::Stream_Commit_Half(uint32_t* _pulHalf)
+	{
+		uint8_t Half = 0;
+
+		if ((_pulHalf == NULL) || (this->pulStream_Buffer == NULL))
+		{
+			return false;
+		}
+		if (_pulHalf == this->pulStream_Buffer)
+		{
+			Half = 0x01;
+		}
+		else if (_pulHalf == this->pulStream_Buffer + ((uint32_t)this->usStream_Frames / 2) * 4)
+		{
+			Half = 0x02;
+		}
+		else
+		{
+			return false;
+		}
+
+		HARDWARE_PWM_ENTER_CRITICAL();
+		this->ucStream_Ready |= Half;
+		HARDWARE_PWM_EXIT_CRITICAL();
+		return true;
+	}
+
+	/**
+	  * @brief  This function returns the number of halves which are played before they were refilled
+	  * @param  None
+	  * @retval Number of underruns
+	  */
+	uint32_t Hardware_PWM::Get_Stream_Underruns(void)
+	{
+		return this->ulStream_Underruns;
+	}
+
+	/**
+	  * @brief  This function is called by DMA_Half_Callback when the DMA of timer update request has transferred half of the buffer
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::DMA_HalfTransfer_Handler(void)
+	{
+		if (this->xDMA_Mode == StreamMode)
+		{
+			this->Stream_Half_Done(0);
+		}
+	}
+
+	/**
+	  * @brief  This function is called by DMA_Complete_Callback when the DMA of timer update request has transferred the whole buffer
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::DMA_TransferComplete_Handler(void)
+	{
+		if (this->xDMA_Mode == StreamMode)
+		{
+			this->Stream_Half_Done(1);
+		}
+		else if (this->xDMA_Mode == RampMode)
+		{
+			this->Ramp_Finish(this->pulRamp_Frames[((uint32_t)this->usRamp_Frames - 1) * 6]);
+		}
+	}
+
+	/**
+	  * @brief  This function releases a played half of the ring buffer and checks the other half, which is playing now
+	  * @param  _ucHalf: 0 for the first half and 1 for the second half
+	  * @retval None
+	  */
+	void Hardware_PWM::Stream_Half_Done(uint8_t _ucHalf)
+	{
+		uint8_t Played = (uint8_t)(1 << _ucHalf);
+		uint8_t Playing = (uint8_t)(1 << (_ucHalf ^ 1));
+		uint16_t Half_Frames = this->usStream_Frames / 2;
+
+		if ((this->ucStream_Ready & Playing) == 0)	//The DMA is playing a half which is not refilled
+		{
+			this->ulStream_Underruns++;
+		}
+		this->ucStream_Ready &= (uint8_t)~Played;
+
+		if (this->pxStream_Callback != NULL)	//Refill the played half now
+		{
+			this->pxStream_Callback(this->pulStream_Buffer + (uint32_t)_ucHalf * Half_Frames * 4, Half_Frames, this->pvStream_Context);
+			this->ucStream_Ready |= Played;
+		}
+	}
+
+#if defined(TIM_OCMODE_COMBINED_PWM1)
+	/**
+	  * @brief  This function sets the phase and dutycycle of a channel by the combined PWM mode.
+	  *			Channel 1 uses channel 2 and channel 3 uses channel 4 as its second edge, so channel 2 and 4 should be Disable
+	  *			in PWM_Channels. The output is active from _ulPhase to _ulPhase + _ulDutyTicks. The new values are applied in the
+	  *			next update event by Update_Event_Handler, so HAL_TIM_PeriodElapsedCallback should call it.
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,3
+	  *			_ulPhase: Phase of the pulse start according to timer ticks
+	  *			_ulDutyTicks: Dutycycle according to timer ticks
+	  * @retval true if the phase is set. false if the channel is not 1 or 3, it is Disable, or its partner channel is used
+	  */
+	bool Hardware_PWM::Set_Phase_Ticks(uint8_t _ucChannel, uint32_t _ulPhase, uint32_t _ulDutyTicks)
+	{
+		uint8_t Pair = _ucChannel >> 3;		//0 for channel 1,2 and 1 for channel 3,4
+		uint64_t Counts = this->Timer_Counts();
+		uint64_t Start = _ulPhase % Counts;
+		uint64_t End = Start + ((_ulDutyTicks < Counts) ? _ulDutyTicks : Counts);
+
+		if (((_ucChannel != TIM_CHANNEL_1) && (_ucChannel != TIM_CHANNEL_3)) ||
+			(this->Get_Channel_Mode(Pair * 2) == Disable) || (this->Get_Channel_Mode((Pair * 2) + 1) != Disable))
+		{
+			return false;
+		}
+
+		if (End <= Counts)	//The pulse is inside the PWM period: CCRa <= CNT < CCRb
+		{
+			this->ulPhase_Compare[Pair * 2] = (uint32_t)Start;
+			this->ulPhase_Compare[(Pair * 2) + 1] = (uint32_t)End;
+			this->ucPhase_Wrap &= (uint8_t)~(1 << Pair);
+		}
+		else	//The pulse passes the update event: CNT < CCRa or CNT >= CCRb
+		{
+			this->ulPhase_Compare[Pair * 2] = (uint32_t)(End - Counts);
+			this->ulPhase_Compare[(Pair * 2) + 1] = (uint32_t)Start;
+			this->ucPhase_Wrap |= (uint8_t)(1 << Pair);
+		}
+		this->ucPhase_Pending |= (uint8_t)(1 << Pair);
+		this->Update_Interrupt_Enable();	//It is disabled in the update event which applies the phase
+		return true;
+	}
+
+	/**
+	  * @brief  This function sets the phase and dutycycle of a channel by the combined PWM mode. See Set_Phase_Ticks
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,3
+	  *			_Phase: Phase of the pulse start according to degree
+	  *			_DutyCycle: Dutycycle value according to percent.
+	  * @retval true if the phase is set
+	  */
+	bool Hardware_PWM::Set_Phase_Degrees(uint8_t _ucChannel, double _Phase, double _DutyCycle)
+	{
+		return this->Set_Phase_Ticks(_ucChannel, (uint32_t)(this->Timer_Counts() * (_Phase / 360.0)),
+									 (uint32_t)(this->Timer_Counts() * (_DutyCycle / 100.0)));
+	}
+#endif
+
+	/**
+	  * @brief  This function should be called in each update event of timer (HAL_TIM_PeriodElapsedCallback).
+	  *			It applies the posted commands, the pulse train segments, the phase changes and the dithered dutycycles.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Update_Event_Handler(void)
+	{
+		HARDWARE_PWM_PROBE(Probe_Update_Event_Handler);
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
+		uint32_t Capacity = (this->pxTimerSpecs_Data->_xTimerIs32bit == true) ? 0xFFFFFFFF : 0xFFFF;
+		uint32_t Step = 0;
+
+		if ((this->xCommand_Enabled == true) && (this->xPulse_Running == false))	//The pulse train owns the timer
+		{
+			this->Command_Apply();
+		}
+
+		if (this->xPulse_Running == true)
+		{
+			if ((Timer->CR1 & TIM_CR1_CEN) == 0)	//The counter is stopped by the one pulse mode, so the last pulse is generated
+			{
+				this->Pulse_Train_Finish();
+			}
+			else if (this->Pulse_Load_Next() == false)	//The running part is the last one
+			{
+				Timer->CR1 |= TIM_CR1_OPM;
+			}
+		}
+		else if (this->ulPhase_Stretch != 0)	//Delay the counter by a longer period
+		{
+			Step = Capacity - this->ulTimer_Period;
+			if (Step > this->ulPhase_Stretch)
+			{
+				Step = this->ulPhase_Stretch;
+			}
+			this->Timer_Store_Period(this->ulTimer_Period + Step);	//It is loaded in the next update event, because the group sets ARPE
+			this->ulPhase_Stretch -= Step;
+		}
+		else if ((this->xDMA_Mode != SpreadSpectrumMode) && (this->xDMA_Mode != RampMode) && (this->ulPeriod_Shadow != this->ulTimer_Period))	//Restore the period after the longer period
+		{
+			this->Timer_Store_Period(this->ulTimer_Period);
+		}
+
+#if defined(TIM_OCMODE_COMBINED_PWM1)
+		Register_Type* CCMR = NULL;
+		uint32_t Mode = 0;
+
+		for (uint8_t Pair = 0; Pair < 2; Pair++)
+		{
+			if (((this->ucPhase_Pending & (1 << Pair)) != 0) && (this->xPulse_Running == false))
+			{
+				CCMR = (Pair == 0) ? &Timer->CCMR1 : &Timer->CCMR2;
+				if ((this->ucPhase_Wrap & (1 << Pair)) != 0)
+				{
+					Mode = TIM_OCMODE_COMBINED_PWM1 | (TIM_OCMODE_PWM2 << 8);	//OR of (CNT < CCRa) and (CNT >= CCRb)
+				}
+				else
+				{
+					Mode = TIM_OCMODE_COMBINED_PWM2 | (TIM_OCMODE_PWM1 << 8);	//AND of (CNT >= CCRa) and (CNT < CCRb)
+				}
+				*CCMR &= ~(TIM_CCMR1_OC1PE | TIM_CCMR1_OC2PE);	//The counter is at the beginning of period, so write the active registers
+				MODIFY_REG(*CCMR, TIM_CCMR1_OC1M | TIM_CCMR1_OC2M, Mode);
+				this->Channel_Store_Compare(Pair * 2, this->ulPhase_Compare[Pair * 2]);
+				this->Channel_Store_Compare((Pair * 2) + 1, this->ulPhase_Compare[(Pair * 2) + 1]);
+				*CCMR |= (TIM_CCMR1_OC1PE | TIM_CCMR1_OC2PE);
+				this->ucPhase_Pending &= (uint8_t)~(1 << Pair);
+			}
+		}
+#endif
+
+		if ((this->ucDither_Channels != 0) && (this->xPulse_Running == false))
+		{
+			for (uint8_t i = 0; i < 4; i++)
+			{
+				if ((this->ucDither_Channels & (1 << i)) != 0)
+				{
+					this->Channel_Store_Compare(i, this->Dither_Next(i));	//It is loaded in the next update event
+				}
+			}
+		}
+		this->Update_Interrupt_Release();	//The phase changes are applied
+	}
+
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+	/**
+	  * @brief  This function returns the execution time statistics of functions. It is a fixed size structure,
+	  *			so it can be sent as a block by the telemetry link.
+	  * @param  None
+	  * @retval The address of statistics
+	  */
+	const PWM_Statistics_Type* Hardware_PWM::Get_Statistics(void)
+	{
+		return &this->xStatistics;
+	}
+
+	/**
+	  * @brief  This function clears the execution time statistics
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Reset_Statistics(void)
+	{
+		for (uint8_t i = 0; i < Probe_Count; i++)
+		{
+			this->xStatistics.xProbes[i].ulCalls = 0;
+			this->xStatistics.xProbes[i].ulMin = 0;
+			this->xStatistics.xProbes[i].ulMax = 0;
+			for (uint8_t j = 0; j < HARDWARE_PWM_HISTOGRAM_BINS; j++)
+			{
+				this->xStatistics.xProbes[i].ulHistogram[j] = 0;
+			}
+		}
+		this->xStatistics.ulSkipped_Writes = 0;
+		this->xStatistics.ulSaved_HAL_Calls = 0;
+	}
+#endif
+
+	/**
+	  * @brief  This function starts the command mailbox. The posted dutycycles and frequency are applied by
+	  *			Update_Event_Handler in the next update event, so the update interrupt is enabled.
+	  *			The Post functions calculate the register values in the caller, so the update interrupt only copies them.
+	  *			They never block and never disable interrupts, but they should be called from one task (or interrupt) with
+	  *			a lower priority than the update interrupt. If several values are posted for a channel in one period, only
+	  *			the last one is applied. A posted value is written in the first update event after it and it is loaded by
+	  *			the timer in the next update event. While the mailbox is used, change the frequency only by Post_Frequency.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Start_Command_Queue(void)
+	{
+		Command_Record_Type* Record = &this->xCommand_Record[0];
+
+		Record->_ulPrescaler = (uint32_t)this->ulTimer_Prescaler;	//The posted values start from the current values
+		Record->_ulPeriod = this->ulTimer_Period;
+		Record->_ulFrequency = this->pxTimerSpecs_Data->_ulFrequency;
+		Record->_Frequency = this->dTimer_Frequency;
+		Record->_ulCounts = this->Timer_Counts();
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			Record->_ulCompare[i] = this->Channel_Read_Compare(i);
+			this->ulCommand_DutyCycle[i] = (uint32_t)(((uint64_t)Record->_ulCompare[i] << 16) / Record->_ulCounts);
+			this->ucCommand_Pending[i] = 0;
+		}
+		this->ucCommand_Pending_Frequency = 0;
+		this->ucCommand_Record = 0;
+		__DMB();
+		this->xCommand_Enabled = true;
+		this->Update_Interrupt_Enable();
+	}
+
+	/**
+	  * @brief  This function stops the command mailbox. The posted values which are not applied are discarded.
+	  *			The update interrupt is disabled if this class enabled it and no other function uses it.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Stop_Command_Queue(void)
+	{
+		this->xCommand_Enabled = false;
+		this->ucCommand_Pending_Frequency = 0;
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			this->ucCommand_Pending[i] = 0;
+		}
+		this->Update_Interrupt_Release();
+	}
+
+	/**
+	  * @brief  This function returns the record which is not read by the update interrupt, filled by the last posted values
+	  * @param  None
+	  * @retval The address of record
+	  */
+	Command_Record_Type* Hardware_PWM::Command_Next_Record(void)
+	{
+		uint8_t Last = this->ucCommand_Record;
+
+		this->xCommand_Record[Last ^ 1] = this->xCommand_Record[Last];
+		return &this->xCommand_Record[Last ^ 1];
+	}
+
+	/**
+	  * @brief  This function posts the dutycycle of a running channel. It never blocks and never disables interrupts.
+	  *			The Capture Compare Register value is calculated here by the period of the last posted frequency.
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+	  *			_ulDutyCycle: Dutycycle value in Q16 format. 0x10000 means 100%
+	  * @retval None
+	  */
+	void Hardware_PWM::Post_DutyCycle_Q16(uint8_t _ucChannel, uint32_t _ulDutyCycle)
+	{
+		uint8_t Index = _ucChannel >> 2;
+		Command_Record_Type* Record = this->Command_Next_Record();
+
+		this->ulCommand_DutyCycle[Index] = _ulDutyCycle;
+		Record->_ulCompare[Index] = (uint32_t)((Record->_ulCounts * _ulDutyCycle) >> 16);
+		this->Command_Publish(Record, (uint8_t)(1 << Index));
+	}
+
+	/**
+	  * @brief  This function posts the dutycycle of a running channel. It never blocks and never disables interrupts.
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+	  *			_DutyCycle: Dutycycle value according to percent.
+	  * @retval None
+	  */
+	void Hardware_PWM::Post_DutyCycle(uint8_t _ucChannel, double _DutyCycle)
+	{
+		this->Post_DutyCycle_Q16(_ucChannel, (uint32_t)(65536.0 * (_DutyCycle / 100.0)));
+	}
+
+	/**
+	  * @brief  This function posts the PWM frequency. It is changed without stopping the outputs and the dutycycles are kept.
+	  *			The prescaler, the period and the Capture Compare Registers of the posted dutycycles are calculated here.
+	  *			It never blocks and never disables interrupts.
+	  * @param  _ulNewFrequency: PWM frequency according to Hz
+	  * @retval true if the frequency is posted. false if it is 0 or out of the timer range
+	  */
+	bool Hardware_PWM::Post_Frequency(uint32_t _ulNewFrequency)
+	{
+		Command_Record_Type* Record = NULL;
+		uint64_t Prescaler = 0;
+		uint32_t Period = 0;
+
+		if (this->Timer_Frequency_Is_Valid(_ulNewFrequency) == false)
+		{
+			return false;
+		}
+		this->Timer_Solve(_ulNewFrequency, &Prescaler, &Period);
+
+		Record = this->Command_Next_Record();
+		Record->_ulPrescaler = (uint32_t)Prescaler;
+		Record->_ulPeriod = Period;
+		Record->_ulFrequency = _ulNewFrequency;
+		Record->_ulCounts = this->Timer_Is_Center_Aligned() ? (uint64_t)Period : ((uint64_t)Period + 1);
+		Record->_Frequency = (double)this->Timer_Get_Frequency() / ((double)(Prescaler + 1) * Record->_ulCounts * (this->Timer_Is_Center_Aligned() ? 2 : 1));
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			Record->_ulCompare[i] = (uint32_t)((Record->_ulCounts * this->ulCommand_DutyCycle[i]) >> 16);
+		}
+		this->Command_Publish(Record, 0);
+		return true;
+	}
+
+	/**
+	  * @brief  This function calculates the ADC trigger of a record and makes it the last posted record. Then the flags of
+	  *			changed values are set, so the update interrupt always reads a complete record.
+	  * @param  _pxRecord: The record which is returned by Command_Next_Record
+	  *			_ucChannels: Bit 0 to bit 3 show the dutycycle of channel 1,2,3,4 is posted. 0 means a frequency is posted
+	  * @retval None
+	  */
+	void Hardware_PWM::Command_Publish(Command_Record_Type* _pxRecord, uint8_t _ucChannels)
+	{
+		uint8_t Trigger = this->xTrigger._ucChannel >> 2;
+
+		if (this->xTrigger_Enabled == true)
+		{
+			_pxRecord->_ulCompare[Trigger] = this->ADC_Trigger_Point(_pxRecord->_ulCounts, _pxRecord->_ulCompare[this->xTrigger._ucReference >> 2]);
+			_ucChannels |= (_ucChannels != 0) ? (uint8_t)(1 << Trigger) : 0;
+		}
+		__DMB();
+		this->ucCommand_Record ^= 1;	//Publish the record before the flags
+		__DMB();
+		if (_ucChannels == 0)
+		{
+			this->ucCommand_Pending_Frequency = 1;
+		}
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			if ((_ucChannels & (1 << i)) != 0)
+			{
+				this->ucCommand_Pending[i] = 1;
+			}
+		}
+	}
+
+	/**
+	  * @brief  This function copies the posted values to the timer in one pass. Each flag is cleared before the record is read,
+	  *			so a value which is posted during this function is applied again in the next update event. The record has
+	  *			all register values, so nothing is calculated in the interrupt.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Command_Apply(void)
+	{
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
+		const Command_Record_Type* Record = NULL;
+
+		this->Begin_Update();
+		if (this->ucCommand_Pending_Frequency != 0)
+		{
+			this->ucCommand_Pending_Frequency = 0;
+			__DMB();
+			Record = &this->xCommand_Record[this->ucCommand_Record];
+			this->ulTimer_Prescaler = Record->_ulPrescaler;
+			this->ulTimer_Period = Record->_ulPeriod;
+			this->dTimer_Frequency = Record->_Frequency;
+			this->pxTimerSpecs_Data->_ulFrequency = Record->_ulFrequency;
+			this->pxTimer->Init.Prescaler = Record->_ulPrescaler;	//Keep the handle the same as the timer
+			this->pxTimer->Init.Period = Record->_ulPeriod;
+			this->pxTimer->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+			Timer->CR1 |= TIM_CR1_ARPE;		//The period is loaded in the update event
+			this->Timer_Store_Prescaler(Record->_ulPrescaler);
+			this->Timer_Store_Period(Record->_ulPeriod);
+			for (uint8_t i = 0; i < 4; i++)
+			{
+				if ((this->Get_Channel_Mode(i) != Disable) || ((this->xTrigger_Enabled == true) && (i == (this->xTrigger._ucChannel >> 2))))
+				{
+					this->Channel_Store_Compare(i, Record->_ulCompare[i]);
+				}
+			}
+		}
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			if (this->ucCommand_Pending[i] != 0)
+			{
+				this->ucCommand_Pending[i] = 0;
+				__DMB();
+				Record = &this->xCommand_Record[this->ucCommand_Record];
+				this->Channel_Store_Compare(i, Record->_ulCompare[i]);
+			}
+		}
+		this->End_Update();
+	}
+
+	/**
+	  * @brief  This function sets the dutycycle of a running channel with 8 fractional bits.
+	  *			The Capture Compare Register is dithered in each PWM period by a sigma-delta modulator, so the average
+	  *			dutycycle has a higher resolution than the timer. Start_Dithering should be called before.
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+	  *			_ulTicks_Q8: Dutycycle value according to timer ticks * 256
+	  * @retval None
+	  */
+	void Hardware_PWM::Set_DutyCycle_HighRes_Q8(uint8_t _ucChannel, uint32_t _ulTicks_Q8)
+	{
+		this->ulDither_Target[_ucChannel >> 2] = _ulTicks_Q8;
+		this->ucDither_Channels |= (uint8_t)(1 << (_ucChannel >> 2));
+	}
+
+	/**
+	  * @brief  This function sets the dutycycle of a running channel in high resolution mode according to percent
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+	  *			_DutyCycle: Dutycycle value according to percent.
+	  * @retval None
+	  */
+	void Hardware_PWM::Set_DutyCycle_HighRes(uint8_t _ucChannel, double _DutyCycle)
+	{
+		this->Set_DutyCycle_HighRes_Q8(_ucChannel, (uint32_t)(this->Timer_Counts() * 256.0 * (_DutyCycle / 100.0)));
+	}
+
+	/**
+	  * @brief  This function starts the sigma-delta dithering of high resolution channels.
+	  *			The dithering is done by Update_Event_Handler in each update event, or by the DMA burst if the buffer of
+	  *			Start_Streaming is filled by Dither_Stream_Callback. The update interrupt is enabled for the first case.
+	  * @param  _ucOrder: Order of sigma-delta modulator. It can be 1 or 2. The second order pushes the dithering noise to
+	  *					  higher frequencies, so the output filter removes it better
+	  *			_xUseInterrupt: true to dither in the update interrupt, false to dither by Start_Streaming
+	  * @retval None
+	  */
+	void Hardware_PWM::Start_Dithering(uint8_t _ucOrder, bool _xUseInterrupt)
+	{
+		this->ucDither_Order = (_ucOrder >= 2) ? 2 : 1;
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			this->lDither_Error[i][0] = 0;
+			this->lDither_Error[i][1] = 0;
+		}
+		if (_xUseInterrupt == true)
+		{
+			this->xDither_Interrupt = true;
+			this->Update_Interrupt_Enable();
+		}
+	}
+
+	/**
+	  * @brief  This function stops the dithering. The channels keep their last Capture Compare Register values.
+	  *			The update interrupt is disabled if this class enabled it and no other function uses it.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Stop_Dithering(void)
+	{
+		this->ucDither_Channels = 0;
+		this->xDither_Interrupt = false;
+		this->Update_Interrupt_Release();
+	}
+
+	/**
+	  * @brief  This function checks the functions which need Update_Event_Handler in the update interrupt
+	  * @param  None
+	  * @retval true if the command queue, a pulse train, the dithering or a phase change uses the update interrupt.
+	  *			A stretched period of group phase uses it until the period is restored.
+	  */
+	bool Hardware_PWM::Update_Interrupt_Is_Used(void)
+	{
+		return (this->xCommand_Enabled == true) || (this->xPulse_Running == true) || (this->xDither_Interrupt == true) ||
+			   (this->ucPhase_Pending != 0) || (this->ulPhase_Stretch != 0) ||
+			   ((this->xDMA_Mode != SpreadSpectrumMode) && (this->xDMA_Mode != RampMode) && (this->ulPeriod_Shadow != this->ulTimer_Period));
+	}
+
+	/**
+	  * @brief  This function enables the update interrupt for a function which needs Update_Event_Handler. If the
+	  *			interrupt is enabled before (for example by HAL_TIM_Base_Start_IT), it is not disabled by this class.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Update_Interrupt_Enable(void)
+	{
+		if ((this->pxTimer->Instance->DIER & TIM_DIER_UIE) == 0)
+		{
+			this->xUpdate_Interrupt = true;
+			__HAL_TIM_ENABLE_IT(this->pxTimer, TIM_IT_UPDATE);
+		}
+	}
+
+	/**
+	  * @brief  This function disables the update interrupt if this class enabled it and no function uses it
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Update_Interrupt_Release(void)
+	{
+		if ((this->xUpdate_Interrupt == true) && (this->Update_Interrupt_Is_Used() == false))
+		{
+			__HAL_TIM_DISABLE_IT(this->pxTimer, TIM_IT_UPDATE);
+			this->xUpdate_Interrupt = false;
+		}
+	}
+
+	/**
+	  * @brief  This function checks the software PWM channels which are attached to the timer
+	  * @param  None
+	  * @retval true if the compare interrupt of software PWM channels is enabled
+	  */
+	bool Hardware_PWM::Software_Is_Running(void)
+	{
+		return (this->pxSoftware != NULL) && (__HAL_TIM_GET_IT_SOURCE(this->pxTimer, this->pxSoftware->ulCompare_Flag) != RESET);
+	}
+
+	/**
+	  * @brief  This function configures the compare channel of attached software PWM channels again and scales their edges
+	  *			to the new period. It is called after the frequency is changed.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Software_Resync(void)
+	{
+		if (this->pxSoftware != NULL)
+		{
+			this->pxSoftware->Compare_Config();		//Timer_Init configures all channels
+			this->pxSoftware->Update_Period();
+		}
+	}
+
+	/**
+	  * @brief  This function fills frames of CCR1,CCR2,CCR3,CCR4 values by the dithered dutycycles.
+	  *			The channels which are not in high resolution mode keep their current value.
+	  *			Use it as the callback of Start_Streaming with the address of Hardware_PWM object as context.
+	  * @param  _pulFrames: The address of frames
+	  *			_usFrameCount: The number of frames
+	  *			_pvContext: The address of Hardware_PWM object
+	  * @retval None
+	  */
+	void Hardware_PWM::Dither_Stream_Callback(uint32_t* _pulFrames, uint16_t _usFrameCount, void* _pvContext)
+	{
+		Hardware_PWM* PWM = (Hardware_PWM*)_pvContext;
+
+		for (uint16_t n = 0; n < _usFrameCount; n++)
+		{
+			for (uint8_t i = 0; i < 4; i++)
+			{
+				if ((PWM->ucDither_Channels & (1 << i)) != 0)
+				{
+					_pulFrames[(n * 4) + i] = PWM->Dither_Next(i);
+				}
+				else
+				{
+					_pulFrames[(n * 4) + i] = PWM->Channel_Read_Compare(i);
+				}
+			}
+		}
+	}
+
+	/**
+	  * @brief  This function calculates the next Capture Compare Register value of a dithered channel by error feedback.
+	  *			First order:  u = x + e[n-1]
+	  *			Second order: u = x + 2 * e[n-1] - e[n-2]
+	  *			The output is the integer part of u and e[n] is the fractional part which is not applied.
+	  *			When the output is clamped to 0 or 100%, the errors are cleared (anti-windup), so the integrators do not
+	  *			grow and the modulator follows the target at once when it is in the range again.
+	  * @param  _ucIndex: The channel index. It can be 0,1,2,3 for channel 1,2,3,4
+	  * @retval Capture Compare Register value
+	  */
+	uint32_t Hardware_PWM::Dither_Next(uint8_t _ucIndex)
+	{
+		int64_t Value = (int64_t)this->ulDither_Target[_ucIndex] + this->lDither_Error[_ucIndex][0];
+		int64_t Output = 0;
+		int64_t Maximum = (int64_t)this->Timer_Counts() << 8;
+
+		if (this->ucDither_Order == 2)
+		{
+			Value += this->lDither_Error[_ucIndex][0] - this->lDither_Error[_ucIndex][1];
+		}
+
+		Output = Value & ~(int64_t)0xFF;	//Quantize to timer ticks
+		if ((Output < 0) || (Output > Maximum))
+		{
+			Output = (Output < 0) ? 0 : Maximum;
+			this->lDither_Error[_ucIndex][0] = 0;
+			this->lDither_Error[_ucIndex][1] = 0;
+			return (uint32_t)(Output >> 8);
+		}
+
+		this->lDither_Error[_ucIndex][1] = this->lDither_Error[_ucIndex][0];
+		this->lDither_Error[_ucIndex][0] = (int32_t)(Value - Output);
+		return (uint32_t)(Output >> 8);
+	}
+
+	/**
+	  * @brief  This function generates exactly _ulPulses pulses at the current PWM frequency and then stops the counter.
+	  *			See Start_Pulse_Profile.
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+	  *			_ulPulses: The number of pulses
+	  *			_DutyCycle: Dutycycle value according to percent.
+	  * @retval true if the pulse train is started
+	  */
+	bool Hardware_PWM::Start_Pulse_Train(uint8_t _ucChannel, uint32_t _ulPulses, double _DutyCycle)
+	{
+		if (this->xPulse_Running == true)	//The single segment is used by the running pulse train
+		{
+			return false;
+		}
+		this->xPulse_Single._ulPeriod = this->ulTimer_Period;
+		this->xPulse_Single._ulPulses = _ulPulses;
+		return this->Start_Pulse_Profile(_ucChannel, &this->xPulse_Single, 1, _DutyCycle);
+	}
+
+	/**
+	  * @brief  This function generates a pulse train from a table of segments. Each segment is a number of pulses with the
+	  *			same period, so an acceleration profile is a table of decreasing periods (see Pulse_Ramp_Build).
+	  *			The repetition counter counts the pulses, so the timer generates up to Timer_Repetition_Max() + 1 pulses
+	  *			without CPU.
+	  *			Update_Event_Handler loads the next part of the table in each update event, and the one pulse mode is set
+	  *			in the last part, so the counter is stopped by hardware after the last pulse. HAL_TIM_PeriodElapsedCallback
+	  *			should call Update_Event_Handler and each part should be longer than the interrupt latency.
+	  *			The channel uses PWM mode 2, so the pulse is at the end of each period and the output is inactive when the
+	  *			counter stops. The whole timer is used by the pulse train, so other channels are stopped. The prescaler
+	  *			is not changed, so the periods should fit in the timer at the current prescaler.
+	  *			The pulse train is not started while the command mailbox, dithering or a phase change uses the update
+	  *			event or software PWM channels are attached, and the posted commands and dithered dutycycles are not applied until the pulse train is finished.
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+	  *			_pxSegments: The address of segment table. It should be valid until the pulse train is finished
+	  *			_usSegmentCount: The number of segments
+	  *			_DutyCycle: Dutycycle value according to percent.
+	  * @retval true if the pulse train is started
+	  */
+	bool Hardware_PWM::Start_Pulse_Profile(uint8_t _ucChannel, const Pulse_Segment_Type* _pxSegments, uint16_t _usSegmentCount, double _DutyCycle)
+	{
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
+		uint8_t Index = _ucChannel >> 2;
+		bool Has_Pulses = false;
+
+		for (uint16_t i = 0; i < _usSegmentCount; i++)
+		{
+			if (_pxSegments[i]._ulPulses != 0)
+			{
+				Has_Pulses = true;
+			}
+		}
+		if ((Has_Pulses == false) || (this->Get_Channel_Mode(Index) == Disable) || (this->xPulse_Running == true) ||
+			(this->xDMA_Mode != IdleMode) || !IS_TIM_REPETITION_COUNTER_INSTANCE(Timer) || (this->xCommand_Enabled == true) ||
+			(this->ucDither_Channels != 0) || (this->ucPhase_Pending != 0) || (this->ulPhase_Stretch != 0) || (this->pxSoftware != NULL))
+		{
+			return false;
+		}
+
+		this->Stop_All_PWM();
+		Timer->CR1 &= ~TIM_CR1_CEN;
+		this->xPulse_Interrupt = ((Timer->DIER & TIM_DIER_UIE) != 0);
+		__HAL_TIM_DISABLE_IT(this->pxTimer, TIM_IT_UPDATE);
+
+		this->ucPulse_Channel = Index;
+		this->ulPulse_DutyCycle = (uint32_t)(65536.0 * (_DutyCycle / 100.0));
+		this->pxPulse_Segments = _pxSegments;
+		this->usPulse_Segment_Count = _usSegmentCount;
+		this->usPulse_Segment = 0;
+		this->ulPulse_Left = 0;
+		this->Channel_Set_OC_Mode(Index, TIM_OCMODE_PWM2);
+
+		Timer->CR1 &= ~TIM_CR1_OPM;
+		Timer->CR1 |= TIM_CR1_ARPE | TIM_CR1_URS;	//The update generation does not make an interrupt
+		this->Pulse_Load_Next();
+		Timer->EGR = TIM_EGR_UG;	//Load the first part to the active registers
+		__HAL_TIM_CLEAR_FLAG(this->pxTimer, TIM_FLAG_UPDATE);
+		if (this->Pulse_Load_Next() == false)	//The first part is the last one
+		{
+			Timer->CR1 |= TIM_CR1_OPM;
+		}
+
+		this->xPulse_Running = true;
+		__HAL_TIM_ENABLE_IT(this->pxTimer, TIM_IT_UPDATE);
+		this->Channel_Outputs_Enable((uint8_t)(1 << Index));	//It enables the counter too
+		return true;
+	}
+
+	/**
+	  * @brief  This function stops the pulse train before its last pulse
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Stop_Pulse_Train(void)
+	{
+		if (this->xPulse_Running == true)
+		{
+			this->pxTimer->Instance->CR1 &= ~TIM_CR1_CEN;
+			this->Pulse_Train_Finish();
+		}
+	}
+
+	/**
+	  * @brief  This function checks the pulse train
+	  * @param  None
+	  * @retval true until the last pulse is generated
+	  */
+	bool Hardware_PWM::Pulse_Train_Is_Running(void)
+	{
+		return this->xPulse_Running;
+	}
+
+	/**
+	  * @brief  This function fills a segment table with a constant acceleration profile from _ulStartFrequency to
+	  *			_ulEndFrequency, so the squared frequency changes linearly with the pulses. It can be used to accelerate
+	  *			or to decelerate. The periods are calculated for the current prescaler, so set the PWM frequency to the
+	  *			lowest frequency of profile by Change_Frequency before. Longer periods are limited to the timer size.
+	  * @param  _pxSegments: The address of segment table
+	  *			_usSegmentCount: The number of segments. More segments make a smoother profile
+	  *			_ulStartFrequency: The frequency of the first pulses according to Hz
+	  *			_ulEndFrequency: The frequency of the last pulses according to Hz
+	  *			_ulPulses: The number of pulses in the whole profile
+	  * @retval None
+	  */
+	void Hardware_PWM::Pulse_Ramp_Build(Pulse_Segment_Type* _pxSegments, uint16_t _usSegmentCount, uint32_t _ulStartFrequency, uint32_t _ulEndFrequency, uint32_t _ulPulses)
+	{
+		bool Center_Aligned = this->Timer_Is_Center_Aligned();
+		double Step_Clock = (double)this->Timer_Get_Frequency() / ((double)(this->ulTimer_Prescaler + 1) * (Center_Aligned ? 2 : 1));
+		double Start_Squared = (double)_ulStartFrequency * _ulStartFrequency;
+		double End_Squared = (double)_ulEndFrequency * _ulEndFrequency;
+		double Capacity = (this->pxTimerSpecs_Data->_xTimerIs32bit == true) ? 4294967295.0 : 65535.0;
+		double Counts = 0;
+		double Frequency = 0;
+		double Position = 0;
+		uint32_t Done = 0;
+
+		for (uint16_t n = 0; n < _usSegmentCount; n++)
+		{
+			_pxSegments[n]._ulPulses = (_ulPulses / _usSegmentCount) + ((n < (_ulPulses % _usSegmentCount)) ? 1 : 0);
+			Position = (_ulPulses != 0) ? ((Done + (_pxSegments[n]._ulPulses / 2.0)) / _ulPulses) : 0;	//At the middle of segment
+			Frequency = sqrt(Start_Squared + ((End_Squared - Start_Squared) * Position));
+			Counts = (Frequency > 0) ? ((Step_Clock / Frequency) + 0.5) : Capacity;
+			if (Counts < 2)
+			{
+				Counts = 2;
+			}
+			else if (Counts > Capacity)
+			{
+				Counts = Capacity;
+			}
+			_pxSegments[n]._ulPeriod = (uint32_t)(Center_Aligned ? Counts : (Counts - 1));
+			Done += _pxSegments[n]._ulPulses;
+		}
+	}
+
+	/**
+	  * @brief  This function writes the period, the repetition counter and the compare value of the next part of pulse
+	  *			train. They are loaded in the next update event. A segment which is longer than the repetition counter is
+	  *			split, and a short remainder is avoided, so the next interrupt has time to run.
+	  * @param  None
+	  * @retval false if all segments are loaded
+	  */
+	bool Hardware_PWM::Pulse_Load_Next(void)
+	{
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
+		bool Center_Aligned = this->Timer_Is_Center_Aligned();
+		uint32_t Maximum = Center_Aligned ? ((this->Timer_Repetition_Max() + 1) / 2) : (this->Timer_Repetition_Max() + 1);	//Center aligned modes count two updates in each period
+		uint32_t Pulses = 0;
+		uint64_t Counts = 0;
+		uint32_t Compare = 0;
+
+		while (this->ulPulse_Left == 0)
+		{
+			if (this->usPulse_Segment >= this->usPulse_Segment_Count)
+			{
+				return false;
+			}
+			this->ulPulse_Period = this->pxPulse_Segments[this->usPulse_Segment]._ulPeriod;
+			this->ulPulse_Left = this->pxPulse_Segments[this->usPulse_Segment]._ulPulses;
+			this->usPulse_Segment++;
+		}
+
+		Pulses = this->ulPulse_Left;
+		if (Pulses > Maximum)
+		{
+			Pulses = (Pulses < (2 * Maximum)) ? (Pulses / 2) : Maximum;
+		}
+		this->ulPulse_Left -= Pulses;
+
+		Counts = Center_Aligned ? (uint64_t)this->ulPulse_Period : ((uint64_t)this->ulPulse_Period + 1);
+		this->Timer_Store_Period(this->ulPulse_Period);
+		Timer->RCR = Center_Aligned ? ((2 * Pulses) - 1) : (Pulses - 1);
+		Compare = (uint32_t)(Counts - ((Counts * this->ulPulse_DutyCycle) >> 16));	//PWM mode 2
+		if (Compare == 0)	//The output would stay active after the counter stops at 0
+		{
+			Compare = 1;
+		}
+		this->Channel_Store_Compare(this->ucPulse_Channel, Compare);
+		return true;
+	}
+
+	/**
+	  * @brief  This function stops the channel of pulse train and restores the timer registers
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Pulse_Train_Finish(void)
+	{
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
+		uint8_t Channel = (uint8_t)(this->ucPulse_Channel << 2);
+
+		this->xPulse_Running = false;
+		if (this->xPulse_Interrupt == false)
+		{
+			__HAL_TIM_DISABLE_IT(this->pxTimer, TIM_IT_UPDATE);
+		}
+		this->Stop_PWM(Channel);
+		this->Channel_Set_OC_Mode(this->ucPulse_Channel, TIM_OCMODE_PWM1);
+		Timer->CR1 &= ~TIM_CR1_OPM;
+		this->Timer_Store_Period(this->ulTimer_Period);
+		Timer->RCR = this->pxTimerSpecs_Data->_ulRepetitionCounter;
+		this->Channel_Store_Compare(this->ucPulse_Channel, 0);
+		Timer->EGR = TIM_EGR_UG;	//Load the registers. It does not make an interrupt
+		__HAL_TIM_CLEAR_FLAG(this->pxTimer, TIM_FLAG_UPDATE);
+		Timer->CR1 &= ~TIM_CR1_URS;
+	}
+
+	/**
+	  * @brief  This function sets the output compare mode of a channel
+	  * @param  _ucIndex: The channel index. It can be 0,1,2,3 for channel 1,2,3,4
+	  *			_ulMode: Output compare mode. It can be TIM_OCMODE_xxx
+	  * @retval None
+	  */
+	void Hardware_PWM::Channel_Set_OC_Mode(uint8_t _ucIndex, uint32_t _ulMode)
+	{
+		Register_Type* CCMR = (_ucIndex < 2) ? &this->pxTimer->Instance->CCMR1 : &this->pxTimer->Instance->CCMR2;
+		uint32_t Shift = (_ucIndex & 1) * 8;	//Channel 2 and 4 use the second byte
+
+		MODIFY_REG(*CCMR, TIM_CCMR1_OC1M << Shift, _ulMode << Shift);
+	}
+
+	/**
+	  * @brief  This function starts the ADC trigger. A compare channel without output makes a rising edge of its reference
+	  *			signal (OCxREF) at the trigger point in each period, and it is connected to the master trigger output, so
+	  *			the ADC should be triggered by the rising edge of TRGO2 (if the timer has it) or TRGO of this timer.
+	  *			The trigger point follows the dutycycle and frequency changes of Start_PWM, Start_All_PWM,
+	  *			Set_All_DutyCycle_Ticks, the frequency changes and the posted commands. After the fast path functions,
+	  *			call Update_ADC_Trigger. In center aligned modes, the trigger is made when the counter counts up, so the
+	  *			position is the counter value, TriggerHighCenter is the bottom and TriggerLowCenter is the top of counter.
+	  *			If the timer has no TRGO2, it can not be the master of a group at the same time.
+	  * @param  _pxTrigger: The trigger configuration. It is copied
+	  * @retval true if the trigger is started
+	  */
+	bool Hardware_PWM::Start_ADC_Trigger(const ADC_Trigger_Type* _pxTrigger)
+	{
+		uint8_t Index = _pxTrigger->_ucChannel >> 2;
+		bool Output_Free = false;
+
+		if (this->Get_Channel_Mode(Index) != Disable)	//The channel has an output
+		{
+			return false;
+		}
+		this->Stop_ADC_Trigger();	//Release the trigger output of the last configuration
+		Output_Free = (this->ulTimer_TriggerOutput == TIM_TRGO_RESET);
+#if defined(TIM_TRGO2_OC4REF)
+		if (IS_TIM_TRGO2_INSTANCE(this->pxTimer->Instance))
+		{
+			Output_Free = true;
+		}
+#endif
+		if (Output_Free == false)	//TRGO is used by a group
+		{
+			return false;
+		}
+
+		this->xTrigger = *_pxTrigger;
+		this->xTrigger_Enabled = true;
+		this->Channel_Set_OC_Mode(Index, TIM_OCMODE_PWM2);	//OCxREF rises when the counter reaches the compare value
+		this->Update_ADC_Trigger();
+		this->Timer_Config_Trigger_Output();
+		return true;
+	}
+
+	/**
+	  * @brief  This function stops the ADC trigger and releases the trigger output
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Stop_ADC_Trigger(void)
+	{
+		uint8_t Index = this->xTrigger._ucChannel >> 2;
+
+		if (this->xTrigger_Enabled == true)
+		{
+			this->xTrigger_Enabled = false;
+			this->Timer_Config_Trigger_Output();
+			this->Channel_Set_OC_Mode(Index, (Index == 2) ? TIM_OCMODE_TIMING : TIM_OCMODE_PWM1);	//The same as Timer_Init
+			this->Channel_Store_Compare(Index, 0);
+		}
+	}
+
+	/**
+	  * @brief  This function calculates the trigger point from the current period and the reference channel and writes it
+	  *			to the trigger channel. It is loaded in the next update event with the other Capture Compare Registers.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Update_ADC_Trigger(void)
+	{
+		if (this->xTrigger_Enabled == true)
+		{
+			this->Channel_Store_Compare(this->xTrigger._ucChannel >> 2, this->ADC_Trigger_Point(this->Timer_Counts(), this->Channel_Read_Compare(this->xTrigger._ucReference >> 2)));
+		}
+	}
+
+	/**
+	  * @brief  This function calculates the Capture Compare Register value of the trigger channel
+	  * @param  _ulCounts: The number of timer ticks in the period (Timer_Counts)
+	  *			_ulCompare: The Capture Compare Register value of the reference channel
+	  * @retval Capture Compare Register value
+	  */
+	uint32_t Hardware_PWM::ADC_Trigger_Point(uint64_t _ulCounts, uint64_t _ulCompare)
+	{
+		bool Center_Aligned = this->Timer_Is_Center_Aligned();
+		int64_t Maximum = Center_Aligned ? (int64_t)_ulCounts : ((int64_t)_ulCounts - 1);	//Auto Reload Register value
+		int64_t Point = 0;
+
+		switch (this->xTrigger._xAnchor)
+		{
+		case TriggerPosition:
+			Point = (int64_t)((_ulCounts * this->xTrigger._ulPosition) >> 16);
+			break;
+		case TriggerHighCenter:
+			Point = Center_Aligned ? 0 : (int64_t)(_ulCompare / 2);	//The active time is around the bottom in center aligned modes
+			break;
+		case TriggerLowCenter:
+			Point = Center_Aligned ? (int64_t)_ulCounts : (int64_t)((_ulCompare + _ulCounts) / 2);	//The inactive time is around the top in center aligned modes
+			break;
+		}
+
+		Point += this->xTrigger._lOffset;
+		if (Point < 1)	//A zero compare value is always active, so it makes no edge
+		{
+			Point = 1;
+		}
+		else if (Point > Maximum)
+		{
+			Point = Maximum;
+		}
+		return (uint32_t)Point;
+	}
+
+	/**
+	  * @brief  This function writes the master trigger outputs. The ADC trigger uses TRGO2 if the timer has it,
+	  *			otherwise TRGO.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Config_Trigger_Output(void)
+	{
+		TIM_MasterConfigTypeDef sMasterConfig = { 0 };
+		static const uint32_t ulTrigger_Sources[4] = { TIM_TRGO_OC1REF, TIM_TRGO_OC2REF, TIM_TRGO_OC3REF, TIM_TRGO_OC4REF };
+		uint32_t Source = ulTrigger_Sources[this->xTrigger._ucChannel >> 2];
+		bool Use_TRGO = true;
+
+#if defined(TIM_TRGO2_OC4REF)
+		static const uint32_t ulTrigger2_Sources[4] = { TIM_TRGO2_OC1REF, TIM_TRGO2_OC2REF, TIM_TRGO2_OC3REF, TIM_TRGO2_OC4REF };
+
+		if (IS_TIM_TRGO2_INSTANCE(this->pxTimer->Instance))	//TRGO stays free for the group
+		{
+			this->ulTimer_TriggerOutput2 = (this->xTrigger_Enabled == true) ? ulTrigger2_Sources[this->xTrigger._ucChannel >> 2] : TIM_TRGO2_RESET;
+			Use_TRGO = false;
+		}
+		sMasterConfig.MasterOutputTrigger2 = this->ulTimer_TriggerOutput2;
+#endif
+		if (Use_TRGO == true)
+		{
+			if (this->xTrigger_Enabled == true)
+			{
+				this->ulTimer_TriggerOutput = Source;
+			}
+			else if (this->ulTimer_TriggerOutput == Source)	//Release TRGO of the ADC trigger
+			{
+				this->ulTimer_TriggerOutput = TIM_TRGO_RESET;
+			}
+		}
+		sMasterConfig.MasterOutputTrigger = this->ulTimer_TriggerOutput;
+		sMasterConfig.MasterSlaveMode = this->ulTimer_MasterSlaveMode;
+		if (HAL_TIMEx_MasterConfigSynchronization(this->pxTimer, &sMasterConfig) != HAL_OK)
+		{
+			Error_Handler();
+		}
+	}
+
+	/**
+	  * @brief  This function configures the break inputs and the idle states of outputs. When a break input is active,
+	  *			the hardware clears the main output enable (MOE) and drives the outputs to their idle states (if OSSR/OSSI
+	  *			are enabled) without CPU, so it is much faster than Stop_All_PWM. The configuration is saved, so
+	  *			Change_Frequency keeps it. The break registers can not be changed after a lock level is written.
+	  *			Forward HAL_TIMEx_BreakCallback (and HAL_TIMEx_Break2Callback) to Break_Event_Handler.
+	  * @param  _pxConfig: The break configuration. It is copied
+	  * @retval None
+	  */
+	void Hardware_PWM::Set_Break_Config(const Break_Config_Type* _pxConfig)
+	{
+		this->xBreak_Config = *_pxConfig;
+		this->Timer_Config_Break((uint8_t)(this->pxTimer->Instance->BDTR & TIM_BDTR_DTG));	//Keep the deadtime
+	}
+
+	/**
+	  * @brief  This function writes the break, deadtime and idle state registers from the saved configuration
+	  * @param  _ucDeadTime: Deadtime register value (DTG)
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Config_Break(uint8_t _ucDeadTime)
+	{
+		TIM_BreakDeadTimeConfigTypeDef sBreakDeadTimeConfig = { 0 };
+		const uint32_t Idle_Mask = TIM_CR2_OIS1 | TIM_CR2_OIS1N | TIM_CR2_OIS2 | TIM_CR2_OIS2N | TIM_CR2_OIS3 | TIM_CR2_OIS3N | TIM_CR2_OIS4;
+
+		MODIFY_REG(this->pxTimer->Instance->CR2, Idle_Mask, ((uint32_t)this->xBreak_Config._ucIdleStates << TIM_CR2_OIS1_Pos) & Idle_Mask);	//It should be written before the lock
+		sBreakDeadTimeConfig.OffStateRunMode = this->xBreak_Config._ulOffStateRunMode;
+		sBreakDeadTimeConfig.OffStateIDLEMode = this->xBreak_Config._ulOffStateIdleMode;
+		sBreakDeadTimeConfig.LockLevel = this->xBreak_Config._ulLockLevel;
+		sBreakDeadTimeConfig.DeadTime = _ucDeadTime;
+		sBreakDeadTimeConfig.BreakState = this->xBreak_Config._ulBreakState;
+		sBreakDeadTimeConfig.BreakPolarity = this->xBreak_Config._ulBreakPolarity;
+#if defined(TIM_BDTR_BKF)
+		sBreakDeadTimeConfig.BreakFilter = this->xBreak_Config._ulBreakFilter;
+#endif
+#if defined(TIM_BDTR_BK2E)
+		sBreakDeadTimeConfig.Break2State = this->xBreak_Config._ulBreak2State;
+		sBreakDeadTimeConfig.Break2Polarity = this->xBreak_Config._ulBreak2Polarity;
+		sBreakDeadTimeConfig.Break2Filter = this->xBreak_Config._ulBreak2Filter;
+#endif
+		sBreakDeadTimeConfig.AutomaticOutput = this->xBreak_Config._ulAutomaticOutput;
+		if (HAL_TIMEx_ConfigBreakDeadTime(this->pxTimer, &sBreakDeadTimeConfig) != HAL_OK)
+		{
+			Error_Handler();
+		}
+
+		if ((this->xBreak_Config._xInterrupt == true) && (this->xBreak_Fault == false))
+		{
+			__HAL_TIM_ENABLE_IT(this->pxTimer, TIM_IT_BREAK);
+		}
+		else
+		{
+			__HAL_TIM_DISABLE_IT(this->pxTimer, TIM_IT_BREAK);
+		}
+	}
+
+	/**
+	  * @brief  This function should be called in the break interrupt (HAL_TIMEx_BreakCallback). The outputs are already
+	  *			disabled by hardware, so it only saves the fault. The break interrupt is disabled until Break_Recover,
+	  *			because the break flag is set again while the break input is active.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Break_Event_Handler(void)
+	{
+		__HAL_TIM_DISABLE_IT(this->pxTimer, TIM_IT_BREAK);
+		this->xBreak_Fault = true;
+		this->ulBreak_Count++;
+	}
+
+	/**
+	  * @brief  This function checks the break status
+	  * @param  None
+	  * @retval true if a break is happened and it is not recovered by Break_Recover
+	  */
+	bool Hardware_PWM::Get_Break_Status(void)
+	{
+		if (__HAL_TIM_GET_FLAG(this->pxTimer, TIM_FLAG_BREAK))
+		{
+			this->xBreak_Fault = true;
+		}
+#if defined(TIM_BDTR_BK2E)
+		if (__HAL_TIM_GET_FLAG(this->pxTimer, TIM_FLAG_BREAK2))
+		{
+			this->xBreak_Fault = true;
+		}
+#endif
+		return this->xBreak_Fault;
+	}
+
+	/**
+	  * @brief  This function returns the number of break events which are handled by Break_Event_Handler
+	  * @param  None
+	  * @retval Number of break events
+	  */
+	uint32_t Hardware_PWM::Get_Break_Count(void)
+	{
+		return this->ulBreak_Count;
+	}
+
+	/**
+	  * @brief  This function clears the break fault and enables the outputs of started channels again.
+	  *			The break flags can not be cleared while a break input is active, so the fault stays.
+	  * @param  None
+	  * @retval true if the fault is cleared
+	  */
+	bool Hardware_PWM::Break_Recover(void)
+	{
+		__HAL_TIM_CLEAR_FLAG(this->pxTimer, TIM_FLAG_BREAK);
+#if defined(TIM_BDTR_BK2E)
+		__HAL_TIM_CLEAR_FLAG(this->pxTimer, TIM_FLAG_BREAK2);
+#endif
+		this->xBreak_Fault = false;
+		if (this->Get_Break_Status() == true)	//A break input is still active
+		{
+			return false;
+		}
+
+		if ((this->pxTimer->Instance->CCER & this->Channel_Enable_Mask(0x0F)) != 0)
+		{
+			__HAL_TIM_MOE_ENABLE(this->pxTimer);
+		}
+		if (this->xBreak_Config._xInterrupt == true)
+		{
+			__HAL_TIM_ENABLE_IT(this->pxTimer, TIM_IT_BREAK);
+		}
+		return true;
+	}
+
+	/**
+	  * @brief  This function changes the PWM frequency.
+	  *			Be carefule, after this function you should start your channels with specific dutycycle.
+	  *			To change the frequency without stopping the outputs, use Change_Frequency_Seamless.
+	  * @param  _ulNewFrequency: PWM frequency according to Hz
+	  * @retval true if the frequency is changed. false if it is 0 or out of the timer range, and nothing is changed
+	  */
+	bool Hardware_PWM::Change_Frequency(uint32_t _ulNewFrequency)
+	{
+		HARDWARE_PWM_PROBE(Probe_Change_Frequency);
+		if (this->Timer_Frequency_Is_Valid(_ulNewFrequency) == false)
+		{
+			return false;
+		}
+		this->Stop_All_PWM();	//At first, stop all channels
+		this->pxTimerSpecs_Data->_ulFrequency = _ulNewFrequency;		//Save the new timer frequency
+		this->Timer_Calculator(this->pxTimerSpecs_Data->_ulFrequency);	//Choose the best values for timer period and timer prescaler
+#if (HARDWARE_PWM_BACKEND == HARDWARE_PWM_BACKEND_HAL)
+		this->Timer_Init();		//Initialize the timer
+		this->Register_Shadow_Sync();
+#else
+		this->Timer_Write_Base();	//Only the prescaler and the period are changed
+#endif
+		this->Software_Resync();
+		return true;
+	}
+
+	/**
+	  * @brief  This function writes the prescaler and the period of a stopped timer and clears the Capture Compare Registers,
+	  *			the same as Timer_Init does, without the HAL initialization. If the timer clock is changed (after
+	  *			Invalidate_Timer_Clock), the deadtime and the clock division are calculated and written again.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Write_Base(void)
+	{
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
+		uint8_t DeadTime = 0;
+
+		if (this->Timer_Get_Frequency() != this->ulTimer_DeadTime_Clock)	//The deadtime is calculated for another timer clock
+		{
+			DeadTime = this->Timer_DeadTime_Calculator();	//It selects the clock division too
+			this->pxTimer->Init.ClockDivision = this->ulTimer_ClockDivision;
+			MODIFY_REG(Timer->CR1, TIM_CR1_CKD, this->ulTimer_ClockDivision);
+			this->Timer_Config_Break(DeadTime);
+		}
+		this->pxTimer->Init.Prescaler = this->ulTimer_Prescaler;	//Keep the handle the same as the timer
+		this->pxTimer->Init.Period = this->ulTimer_Period;
+		this->Timer_Store_Prescaler((uint32_t)this->ulTimer_Prescaler);
+		this->Timer_Store_Period(this->ulTimer_Period);
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			if ((this->pxSoftware == NULL) || (i != this->pxSoftware->ucCompare_Index))	//The compare channel of software PWM is kept
+			{
+				this->Channel_Store_Compare(i, 0);
+			}
+		}
+		this->Update_ADC_Trigger();
+		Timer->CR1 |= TIM_CR1_URS;		//The update generation does not make an interrupt
+		Timer->EGR = TIM_EGR_UG;		//Load the prescaler and the preloaded registers
+		Timer->CR1 &= ~TIM_CR1_URS;
+	}
+
+	/**
+	  * @brief  This function changes the PWM frequency without stopping the outputs.
+	  *			The new prescaler, period and Capture Compare Register values are loaded together in the next update event,
+	  *			and the dutycycle of each channel is kept. The deadtime does not change because the timer clock is the same.
+	  * @param  _ulNewFrequency: PWM frequency according to Hz
+	  * @retval true if the frequency is changed. false if it is 0 or out of the timer range, and nothing is changed
+	  */
+	bool Hardware_PWM::Change_Frequency_Seamless(uint32_t _ulNewFrequency)
+	{
+		HARDWARE_PWM_PROBE(Probe_Change_Frequency_Seamless);
+		if (this->Timer_Frequency_Is_Valid(_ulNewFrequency) == false)
+		{
+			return false;
+		}
+		this->Begin_Update();
+		this->Frequency_Write(_ulNewFrequency);
+		this->End_Update();
+		return true;
+	}
+
+	/**
+	  * @brief  This function calculates the new timer values and writes the registers which are changed.
+	  *			The update event should be held by Begin_Update before. Each Capture Compare Register is calculated from
+	  *			the dutycycle ratio of its channel (ulDuty_Ticks / ulDuty_Counts) and rounded, so the dutycycle does not drift
+	  *			after many frequency changes. The ratio is taken again from the register when it is written by other functions.
+	  * @param  _ulNewFrequency: PWM frequency according to Hz
+	  * @retval true if the frequency is changed. false if it is 0 or out of the timer range, and no register is written
+	  */
+	bool Hardware_PWM::Frequency_Write(uint32_t _ulNewFrequency)
+	{
+		uint64_t Prescaler = 0;
+		uint32_t Period = 0;
+
+		if (this->Timer_Frequency_Is_Valid(_ulNewFrequency) == false)
+		{
+			return false;
+		}
+		this->Timer_Solve(_ulNewFrequency, &Prescaler, &Period);	//Choose the best values for timer period and timer prescaler
+		this->Frequency_Apply(_ulNewFrequency, Prescaler, Period);
+		return true;
+	}
+
+	/**
+	  * @brief  This function saves new timer values and writes the registers which are changed. See Frequency_Write.
+	  *			The update event should be held by Begin_Update before.
+	  * @param  _ulNewFrequency: PWM frequency according to Hz
+	  *			_ulPrescaler: The prescaler register value
+	  *			_ulPeriod: The Auto Reload Register value
+	  * @retval None
+	  */
+	void Hardware_PWM::Frequency_Apply(uint32_t _ulNewFrequency, uint64_t _ulPrescaler, uint32_t _ulPeriod)
+	{
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
+		uint64_t Old_Counts = this->Timer_Counts();
+		uint64_t New_Counts = 0;
+		uint32_t Compare = 0;
+
+		this->pxTimerSpecs_Data->_ulFrequency = _ulNewFrequency;		//Save the new timer frequency
+		this->ulTimer_Prescaler = _ulPrescaler;
+		this->ulTimer_Period = _ulPeriod;
+		this->Timer_Update_Frequency();
+		New_Counts = this->Timer_Counts();
+
+		this->pxTimer->Init.Prescaler = this->ulTimer_Prescaler;	//Keep the handle the same as the timer
+		this->pxTimer->Init.Period = this->ulTimer_Period;
+		this->pxTimer->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+
+		Timer->CR1 |= TIM_CR1_ARPE;		//The period is loaded in the update event
+		if (this->ulTimer_Prescaler != this->ulPrescaler_Shadow)
+		{
+			this->Timer_Store_Prescaler((uint32_t)this->ulTimer_Prescaler);
+		}
+		else
+		{
+			HARDWARE_PWM_COUNT(ulSkipped_Writes, 1);
+		}
+		if (New_Counts == Old_Counts)
+		{
+			HARDWARE_PWM_COUNT(ulSkipped_Writes, 1);
+		}
+		else
+		{
+			this->Timer_Store_Period(this->ulTimer_Period);
+			for (uint8_t i = 0; i < 4; i++)	//Calculate the Capture Compare Registers from the dutycycle ratios
+			{
+				if (this->Get_Channel_Mode(i) != Disable)
+				{
+					Compare = this->Channel_Read_Compare(i);
+					if ((Compare != this->ulDuty_Scaled[i]) || (this->ulDuty_Counts[i] == 0))	//The register is written by another function
+					{
+						this->ulDuty_Ticks[i] = Compare;
+						this->ulDuty_Counts[i] = Old_Counts;
+					}
+					Compare = (uint32_t)(((this->ulDuty_Ticks[i] * New_Counts) + (this->ulDuty_Counts[i] / 2)) / this->ulDuty_Counts[i]);
+					this->ulDuty_Scaled[i] = Compare;
+					this->Channel_Store_Compare(i, Compare);
+				}
+			}
+			this->Update_ADC_Trigger();
+			this->Software_Resync();
+		}
+	}
+
+	/**
+	  * @brief  This function initializes the timer
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Init(void)
+	{
+		HARDWARE_PWM_PROBE(Probe_Timer_Init);
+		TIM_ClockConfigTypeDef sClockSourceConfig = { 0 };
+		TIM_OC_InitTypeDef sConfigOC = { 0 };
+		uint8_t DeadTime = this->Timer_DeadTime_Calculator();	//It selects the clock division too
+
+		this->pxTimer->Init.Prescaler = this->ulTimer_Prescaler;
+		this->pxTimer->Init.CounterMode = this->pxTimerSpecs_Data->_ulCounterMode;
+		this->pxTimer->Init.Period = this->ulTimer_Period;
+		this->pxTimer->Init.ClockDivision = this->ulTimer_ClockDivision;
+		this->pxTimer->Init.RepetitionCounter = this->pxTimerSpecs_Data->_ulRepetitionCounter;
+		this->pxTimer->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+		if (HAL_TIM_Base_Init(this->pxTimer) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
+		if (HAL_TIM_ConfigClockSource(this->pxTimer, &sClockSourceConfig) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		if (HAL_TIM_PWM_Init(this->pxTimer) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		if (HAL_TIM_OC_Init(this->pxTimer) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		this->Timer_Config_Trigger_Output();
+		sConfigOC.OCMode = TIM_OCMODE_PWM1;
+		sConfigOC.Pulse = 0;
+		sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+		sConfigOC.OCNPolarity = TIM_OCNPOLARITY_HIGH;
+		sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+		sConfigOC.OCIdleState = TIM_OCIDLESTATE_RESET;
+		sConfigOC.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+		if (HAL_TIM_PWM_ConfigChannel(this->pxTimer, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		if (HAL_TIM_PWM_ConfigChannel(this->pxTimer, &sConfigOC, TIM_CHANNEL_2) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		sConfigOC.OCMode = TIM_OCMODE_TIMING;
+		if (HAL_TIM_OC_ConfigChannel(this->pxTimer, &sConfigOC, TIM_CHANNEL_3) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		sConfigOC.OCMode = TIM_OCMODE_PWM1;
+		if (HAL_TIM_PWM_ConfigChannel(this->pxTimer, &sConfigOC, TIM_CHANNEL_4) != HAL_OK)
+		{
+			Error_Handler();
+		}
+		__HAL_TIM_ENABLE_OCxPRELOAD(this->pxTimer, TIM_CHANNEL_1);	//New compare values are loaded in the update event
+		__HAL_TIM_ENABLE_OCxPRELOAD(this->pxTimer, TIM_CHANNEL_2);
+		__HAL_TIM_ENABLE_OCxPRELOAD(this->pxTimer, TIM_CHANNEL_3);
+		__HAL_TIM_ENABLE_OCxPRELOAD(this->pxTimer, TIM_CHANNEL_4);
+		this->Timer_Config_Break(DeadTime);
+		if (this->xTimer_IsSlave == true)	//The clock source configuration clears the slave mode
+		{
+			this->Timer_Config_Slave(this->ulTimer_InputTrigger);
+		}
+		if (this->xTrigger_Enabled == true)	//The channel configuration clears the trigger channel
+		{
+			this->Channel_Set_OC_Mode(this->xTrigger._ucChannel >> 2, TIM_OCMODE_PWM2);
+			this->Update_ADC_Trigger();
+		}
+		HAL_TIM_MspPostInit(this->pxTimer);
+	}
+
+	/**
+	  * @brief  This function configures the timer as the master of a group. The trigger output is enabled by the counter enable.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Config_Master(void)
+	{
+		this->ulTimer_TriggerOutput = TIM_TRGO_ENABLE;
+		this->ulTimer_MasterSlaveMode = TIM_MASTERSLAVEMODE_ENABLE;	//Delay the master to start with its slaves
+		this->Timer_Config_Trigger_Output();
+	}
+
+	/**
+	  * @brief  This function configures the timer as a slave of a group. The counter is started by the master trigger output.
+	  * @param  _ulInputTrigger: The internal trigger which is connected to the master. It can be TIM_TS_ITR0,1,2,3
+	  *							 according to the reference manual
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Config_Slave(uint32_t _ulInputTrigger)
+	{
+		TIM_SlaveConfigTypeDef sSlaveConfig = { 0 };
+
+		this->xTimer_IsSlave = true;
+		this->ulTimer_InputTrigger = _ulInputTrigger;
+		sSlaveConfig.SlaveMode = TIM_SLAVEMODE_TRIGGER;
+		sSlaveConfig.InputTrigger = _ulInputTrigger;
+		sSlaveConfig.TriggerPolarity = TIM_TRIGGERPOLARITY_RISING;
+		sSlaveConfig.TriggerPrescaler = TIM_TRIGGERPRESCALER_DIV1;
+		sSlaveConfig.TriggerFilter = 0;
+		if (HAL_TIM_SlaveConfigSynchro(this->pxTimer, &sSlaveConfig) != HAL_OK)
+		{
+			Error_Handler();
+		}
+	}
+
+	/**
+	  * @brief  This function returns the enable bits of used channels in the Capture Compare Enable Register
+	  * @param  _ucChannels: Bit 0 to bit 3 select channel 1,2,3,4
+	  * @retval Channel enable mask
+	  */
+	uint32_t Hardware_PWM::Channel_Enable_Mask(uint8_t _ucChannels)
+	{
+		uint32_t Mask = 0;
+
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			if ((_ucChannels & (1 << i)) == 0)
+			{
+				continue;
+			}
+			if (this->Get_Channel_Mode(i) == SingleMode)
+			{
+				Mask |= TIM_CCER_CC1E << (i * 4);
+			}
+			else if (this->Get_Channel_Mode(i) == ComplementMode)
+			{
+				Mask |= (TIM_CCER_CC1E | TIM_CCER_CC1NE) << (i * 4);
+			}
+		}
+		return Mask;
+	}
+
+	/**
+	  * @brief  This function saves the address of Capture Compare Registers for the fast path functions
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Channel_Registers_Init(void)
+	{
+		this->pulChannel_CCR[0] = &this->pxTimer->Instance->CCR1;
+		this->pulChannel_CCR[1] = &this->pxTimer->Instance->CCR2;
+		this->pulChannel_CCR[2] = &this->pxTimer->Instance->CCR3;
+		this->pulChannel_CCR[3] = &this->pxTimer->Instance->CCR4;
+	}
+
+	/**
+	  * @brief  This function reads the Capture Compare Registers, the period and the prescaler to their software copies.
+	  *			It is called after the registers are written by the HAL or by the DMA.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Register_Shadow_Sync(void)
+	{
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			this->ulCompare_Shadow[i] = *this->pulChannel_CCR[i];
+		}
+		this->ulPeriod_Shadow = this->pxTimer->Instance->ARR;
+		this->ulPrescaler_Shadow = this->pxTimer->Instance->PSC;
+	}
+
+	/**
+	  * @brief  This function returns the mode of a channel
+	  * @param  _ucIndex: The channel index. It can be 0,1,2,3 for channel 1,2,3,4
+	  * @retval Channel mode
+	  */
+	Channel_ModeType Hardware_PWM::Get_Channel_Mode(uint8_t _ucIndex)
+	{
+		switch (_ucIndex)
+		{
+		case 0:
+			return this->pxUsed_Channels->Channel1;
+		case 1:
+			return this->pxUsed_Channels->Channel2;
+		case 2:
+			return this->pxUsed_Channels->Channel3;
+		case 3:
+			return this->pxUsed_Channels->Channel4;
+		}
+		return Disable;
+	}
+
+	/**
+	  * @brief  This function chooses the best value of timer period and timer prescaler according to PWM frequency and timer resolution
+	  *			and saves them. See Timer_Solve.
+	  * @param  _ulFrequency: The frequency of PWM signal according to Hz. It is checked by Timer_Frequency_Is_Valid
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Calculator(uint32_t _ulFrequency)
+	{
+		uint64_t Prescaler = 0;
+		uint32_t Period = 0;
+
+		this->ulTimer_Prescaler = 0;			//Set the initial value
+
+		if (this->Timer_Frequency_Is_Valid(_ulFrequency))
+		{
+			this->Timer_Solve(_ulFrequency, &Prescaler, &Period);
+			this->ulTimer_Prescaler = Prescaler;
+			this->ulTimer_Period = Period;
+			this->Timer_Update_Frequency();
+		}
+	}
+
+	/**
+	  * @brief  This function calculates the best value of timer period and timer prescaler according to PWM frequency and timer
+	  *			resolution. Nothing is saved, so the values of other timers can be derived from them before they are written.
+	  *			The values are calculated in constant time. The smallest prescaler which fits the period in the timer is selected,
+	  *			so the period has the best resolution, and the period is rounded to the nearest value to have the smallest frequency error.
+	  *			In center aligned modes, the counter counts up and down in each PWM period, so the PWM period is 2 * ARR timer clocks.
+	  * @param  _ulFrequency: The frequency of PWM signal according to Hz. It should be checked by Timer_Frequency_Is_Valid
+	  *			_pulPrescaler: The prescaler register value
+	  *			_pulPeriod: The Auto Reload Register value
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Solve(uint32_t _ulFrequency, uint64_t* _pulPrescaler, uint32_t* _pulPeriod)
+	{
+		uint32_t Timer_Clock = this->Timer_Get_Frequency();
+		bool Center_Aligned = this->Timer_Is_Center_Aligned();
+		uint64_t Step_Frequency = (uint64_t)_ulFrequency * (Center_Aligned ? 2 : 1);	//The frequency of counter up or down steps
+		uint64_t Period_Capacity = this->Timer_Period_Capacity();
+		uint64_t Total_Counts = 0;
+		uint64_t Prescaler = 0;
+		uint64_t Period = 0;
+
+		Total_Counts = ((uint64_t)Timer_Clock + (Step_Frequency / 2)) / Step_Frequency;	//The number of timer clocks in one PWM period (or half period)
+		Prescaler = (Total_Counts + Period_Capacity - 1) / Period_Capacity;			//The smallest prescaler which fits the period in the timer
+
+		Period = ((uint64_t)Timer_Clock + ((Prescaler * Step_Frequency) / 2)) / (Prescaler * Step_Frequency);	//Round the period to the nearest value
+		if (Period > Period_Capacity)	//Check the timer period value
+		{
+			Period = Period_Capacity;
+		}
+		else if (Period == 0)
+		{
+			Period = 1;
+		}
+
+		*_pulPrescaler = Prescaler - 1;		//Because of timer
+		*_pulPeriod = (uint32_t)(Center_Aligned ? Period : (Period - 1));	//Because of timer
+	}
+
+	/**
+	  * @brief  This function calculates the frequency which is generated by the saved prescaler and period
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Timer_Update_Frequency(void)
+	{
+		this->dTimer_Frequency = (double)this->Timer_Get_Frequency() / ((double)(this->ulTimer_Prescaler + 1) * this->Timer_Counts() * (this->Timer_Is_Center_Aligned() ? 2 : 1));
+	}
+
+	/**
+	  * @brief  This function checks a PWM frequency before any value is changed. The frequency should be less than 1/10 of
+	  *			the timer clock, and the period should fit in the timer with the largest prescaler (65536).
+	  * @param  _ulFrequency: The frequency of PWM signal according to Hz
+	  * @retval true if the timer can generate the frequency
+	  */
+	bool Hardware_PWM::Timer_Frequency_Is_Valid(uint32_t _ulFrequency)
+	{
+		uint32_t Timer_Clock = this->Timer_Get_Frequency();
+		uint64_t Step_Frequency = (uint64_t)_ulFrequency * (this->Timer_Is_Center_Aligned() ? 2 : 1);
+
+		if ((_ulFrequency == 0) || (_ulFrequency >= (Timer_Clock / 10)))	//Limit the maximum frequency
+		{
+			return false;
+		}
+		return ((((uint64_t)Timer_Clock + (Step_Frequency / 2)) / Step_Frequency) <= (this->Timer_Period_Capacity() * 0x10000));	//The prescaler register is 16 bit
+	}
+
+	/**
+	  * @brief  This function returns the largest number of counts in one period (or half period) of the timer
+	  * @param  None
+	  * @retval 0x10000 or 0x100000000 in edge aligned mode. One less in center aligned modes, because ARR is the number of
+	  *			counts in each direction
+	  */
+	uint64_t Hardware_PWM::Timer_Period_Capacity(void)
+	{
+		uint64_t Capacity = (this->pxTimerSpecs_Data->_xTimerIs32bit == true) ? 0x100000000ULL : 0x10000ULL;
+
+		return this->Timer_Is_Center_Aligned() ? (Capacity - 1) : Capacity;
+	}
+
+	/**
+	  * @brief  This function checks the counter mode of timer
+	  * @param  None
+	  * @retval true if the counter mode is one of center aligned modes
+	  */
+	bool Hardware_PWM::Timer_Is_Center_Aligned(void)
+	{
+		return (this->pxTimerSpecs_Data->_ulCounterMode == TIM_COUNTERMODE_CENTERALIGNED1) ||
+			   (this->pxTimerSpecs_Data->_ulCounterMode == TIM_COUNTERMODE_CENTERALIGNED2) ||
+			   (this->pxTimerSpecs_Data->_ulCounterMode == TIM_COUNTERMODE_CENTERALIGNED3);
+	}
+
+	/**
+	  * @brief  This function returns the number of timer ticks which is the 100% dutycycle
+	  * @param  None
+	  * @retval ARR + 1 in edge aligned mode and ARR in center aligned modes
+	  */
+	uint64_t Hardware_PWM::Timer_Counts(void)
+	{
+		return this->Timer_Is_Center_Aligned() ? (uint64_t)this->ulTimer_Period : ((uint64_t)this->ulTimer_Period + 1);
+	}
+
+	/**
+	  * @brief  This function returns the largest value of repetition counter of the timer. TIM_RCR_REP is the size of the
+	  *			largest repetition counter of the device, but TIM15, TIM16 and TIM17 have an 8 bit counter in all families.
+	  * @param  None
+	  * @retval The largest RCR value. 0 if the timer has no repetition counter
+	  */
+	uint32_t Hardware_PWM::Timer_Repetition_Max(void)
+	{
+		if (!IS_TIM_REPETITION_COUNTER_INSTANCE(this->pxTimer->Instance))
+		{
+			return 0;
+		}
+		for (uint8_t i = 0; i < (sizeof(pxRepetition_8bit_Timers) / sizeof(pxRepetition_8bit_Timers[0])); i++)
+		{
+			if (this->pxTimer->Instance == pxRepetition_8bit_Timers[i])
+			{
+				return 0xFF;
+			}
+		}
+		return TIM_RCR_REP;
+	}
+
+	/**
+	  * @brief  This function sets the number of PWM periods between two update events by the repetition counter,
+	  *			so the update interrupt and the update DMA request are generated in a lower rate.
+	  *			The new value is loaded in the next update event. It is only available in timers with repetition counter.
+	  * @param  _ulPeriods: The number of PWM periods. In center aligned modes, 0 means two update events in each period
+	  *						(at the top and the bottom of counter)
+	  * @retval None
+	  */
+	void Hardware_PWM::Set_Update_Rate(uint32_t _ulPeriods)
+	{
+		uint32_t Repetition = 0;
+
+		if (IS_TIM_REPETITION_COUNTER_INSTANCE(this->pxTimer->Instance))
+		{
+			if (_ulPeriods != 0)
+			{
+				Repetition = this->Timer_Is_Center_Aligned() ? ((_ulPeriods * 2) - 1) : (_ulPeriods - 1);
+			}
+			if (Repetition > this->Timer_Repetition_Max())	//The size of repetition counter depends on the timer
+			{
+				Repetition = this->Timer_Repetition_Max();
+			}
+			this->pxTimerSpecs_Data->_ulRepetitionCounter = Repetition;
+			this->pxTimer->Init.RepetitionCounter = Repetition;
+			this->pxTimer->Instance->RCR = Repetition;
+		}
+	}
+
+	/**
+	  * @brief  This function returns the PWM frequency which is really generated by the timer.
+	  *			It can be different from the requested frequency because of the timer resolution.
+	  * @param  None
+	  * @retval PWM frequency according to Hz
+	  */
+	double Hardware_PWM::Get_Actual_Frequency(void)
+	{
+		return this->dTimer_Frequency;
+	}
+
+	/**
+	  * @brief  This function returns the PWM frequency which the timer would generate for a requested frequency.
+	  *			The prescaler and period are calculated like Change_Frequency, but nothing is written to the timer.
+	  * @param  _ulFrequency: The frequency of PWM signal according to Hz
+	  * @retval PWM frequency according to Hz. 0 if the timer can not generate the frequency
+	  */
+	double Hardware_PWM::Get_Solved_Frequency(uint32_t _ulFrequency)
+	{
+		bool Center_Aligned = this->Timer_Is_Center_Aligned();
+		uint64_t Prescaler = 0;
+		uint32_t Period = 0;
+
+		if (this->Timer_Frequency_Is_Valid(_ulFrequency) == false)
+		{
+			return 0;
+		}
+		this->Timer_Solve(_ulFrequency, &Prescaler, &Period);
+		return (double)this->Timer_Get_Frequency() / ((double)(Prescaler + 1) * (Center_Aligned ? (double)Period : ((double)Period + 1)) * (Center_Aligned ? 2 : 1));
+	}
+
+	/**
+	  * @brief  This function calculates the deadtime register value (DTG) according to deadtime (nS).
+	  *			All four DTG ranges are used and the deadtime is rounded up, so it is never shorter than the requested value:
+	  *			DTG[7] = 0:		DT = DTG[6:0] * tDTS
+	  *			DTG[7:6] = 10:	DT = (64 + DTG[5:0]) * 2 * tDTS
+	  *			DTG[7:5] = 110:	DT = (32 + DTG[4:0]) * 8 * tDTS
+	  *			DTG[7:5] = 111:	DT = (32 + DTG[4:0]) * 16 * tDTS
+	  *			If the deadtime is longer than 1008 * tDTS, the clock division (tDTS = 2 or 4 timer clocks) is used.
+	  *			The selected clock division is saved in ulTimer_ClockDivision and the applied deadtime in ulTimer_DeadTime.
+	  * @param  None
+	  * @retval Deadtime register value
+	  */
+	uint8_t Hardware_PWM::Timer_DeadTime_Calculator(void)
+	{
+		uint32_t Timer_Clock = this->Timer_Get_Frequency();
+		uint64_t Ticks = (((uint64_t)Timer_Clock * this->pxTimerSpecs_Data->_ulDeadTime) + 999999999ULL) / 1000000000ULL;	//Deadtime according to timer clocks
+		uint32_t Division = 1;
+		uint32_t Applied_Ticks = 0;
+		uint8_t DeadTime = 0;
+
+		this->ulTimer_ClockDivision = TIM_CLOCKDIVISION_DIV1;
+		if (Ticks > 1008)	//Use the clock division
+		{
+			Division = 2;
+			this->ulTimer_ClockDivision = TIM_CLOCKDIVISION_DIV2;
+			if (Ticks > (1008 * 2))
+			{
+				Division = 4;
+				this->ulTimer_ClockDivision = TIM_CLOCKDIVISION_DIV4;
+			}
+		}
+
+		Ticks = (Ticks + Division - 1) / Division;	//Deadtime according to tDTS
+		if (Ticks > 1008)	//The maximum deadtime
+		{
+			Ticks = 1008;
+		}
+
+		if (Ticks <= 127)
+		{
+			DeadTime = (uint8_t)Ticks;
+			Applied_Ticks = (uint32_t)Ticks;
+		}
+		else if (Ticks <= 254)
+		{
+			DeadTime = (uint8_t)(0x80 | (((Ticks + 1) / 2) - 64));
+			Applied_Ticks = (64 + (DeadTime & 0x3F)) * 2;
+		}
+		else if (Ticks <= 504)
+		{
+			DeadTime = (uint8_t)(0xC0 | (((Ticks + 7) / 8) - 32));
+			Applied_Ticks = (32 + (DeadTime & 0x1F)) * 8;
+		}
+		else
+		{
+			DeadTime = (uint8_t)(0xE0 | (((Ticks + 15) / 16) - 32));
+			Applied_Ticks = (32 + (DeadTime & 0x1F)) * 16;
+		}
+
+		this->ulTimer_DeadTime_Clocks = Applied_Ticks * Division;
+		this->ulTimer_DeadTime_Clock = Timer_Clock;
+		if (Timer_Clock != 0)
+		{
+			this->ulTimer_DeadTime = (uint32_t)(((uint64_t)Applied_Ticks * Division * 1000000000ULL) / Timer_Clock);	//The applied deadtime according to nS
+		}
+		return DeadTime;
+	}
+
+	/**
+	  * @brief  This function returns the deadtime which is applied by the timer. It can be a little longer than the requested
+	  *			value because of the deadtime register resolution.
+	  * @param  None
+	  * @retval Deadtime according to nS
+	  */
+	uint32_t Hardware_PWM::Get_DeadTime(void)
+	{
+		return this->ulTimer_DeadTime;
+	}
+
+	/**
+	  * @brief  This function calculates the edges of CHx and CHxN outputs in one PWM period from the prescaler, period,
+	  *			Capture Compare Register and deadtime values, without reading the counter. So a host build can replay
+	  *			a command log and check the dutycycle errors and the gaps between the outputs period by period.
+	  *			The channel is modeled in PWM mode 1 with active high outputs: the reference is active while counter < CCR.
+	  *			The deadtime delays the rising edge of each complementary output, so a pulse which is not longer than
+	  *			the deadtime is removed. The Capture Compare Register is read from the preload register, so the edges are
+	  *			the edges of period after the next update event. Phase shifted channels (combined mode) are not modeled.
+	  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+	  *			_pxEdges: The address of edges variable
+	  * @retval false if the channel is disabled in PWM_Channels
+	  */
+	bool Hardware_PWM::Get_Channel_Edges(uint8_t _ucChannel, Channel_Edges_Type* _pxEdges)
+	{
+		uint8_t Index = _ucChannel >> 2;	//TIM_CHANNEL_x values are 0, 4, 8, 12
+		Channel_ModeType Mode = this->Get_Channel_Mode(Index);
+		uint64_t Tick = this->ulTimer_Prescaler + 1;	//Timer clocks of one counter tick
+		uint64_t Counts = this->Timer_Counts();
+		uint64_t Compare = this->Channel_Read_Compare(Index);
+		uint64_t Period = 0;
+		uint64_t Active = 0;
+		uint64_t Start = 0;
+		uint64_t DeadTime = 0;
+
+		if (Mode == Disable)
+		{
+			return false;
+		}
+
+		if (Compare > Counts)	//The reference is always active
+		{
+			Compare = Counts;
+		}
+		if (this->Timer_Is_Center_Aligned())
+		{
+			Period = Counts * Tick * 2;	//Up and down counting
+			Active = Compare * Tick * 2;
+			Start = Period - (Active / 2);	//The active time is around the bottom of counter
+		}
+		else
+		{
+			Period = Counts * Tick;
+			Active = Compare * Tick;	//From the start of period
+		}
+		if (Mode == ComplementMode)	//The deadtime is inserted only between complementary outputs
+		{
+			DeadTime = this->ulTimer_DeadTime_Clocks;
+		}
+
+		_pxEdges->ulClock = this->Timer_Get_Frequency();
+		_pxEdges->ulPeriod = Period;
+		_pxEdges->ulDeadTime = DeadTime;
+		_pxEdges->xOutput.ulRise = 0;
+		_pxEdges->xOutput.ulWidth = 0;
+		_pxEdges->xComplement.ulRise = 0;
+		_pxEdges->xComplement.ulWidth = 0;
+		if (((this->ucChannel_Running & (1 << Index)) == 0) || (Period == 0))	//The outputs are inactive
+		{
+			return true;
+		}
+
+		if (Active == Period)	//No edge, so the deadtime is not inserted
+		{
+			_pxEdges->xOutput.ulWidth = Period;
+		}
+		else if (Active > DeadTime)
+		{
+			_pxEdges->xOutput.ulRise = (Start + DeadTime) % Period;
+			_pxEdges->xOutput.ulWidth = Active - DeadTime;
+		}
+
+		if (Mode == ComplementMode)
+		{
+			if (Active == 0)
+			{
+				_pxEdges->xComplement.ulWidth = Period;
+			}
+			else if ((Period - Active) > DeadTime)
+			{
+				_pxEdges->xComplement.ulRise = (Start + Active + DeadTime) % Period;
+				_pxEdges->xComplement.ulWidth = Period - Active - DeadTime;
+			}
+		}
+		return true;
+	}
+
+	/**
+	  * @brief  This function returns the timer clock frequency.
+	  *			The clock is resolved from the bus clock table once and saved. If the RCC clocks are changed,
+	  *			call Invalidate_Timer_Clock and then Change_Frequency to calculate the timer values again.
+	  * @param  None
+	  * @retval Timer Frequency according to Hz
+	  */
+	uint32_t Hardware_PWM::Timer_Get_Frequency(void)
+	{
+		if (this->ulTimer_Clock == 0)	//The clock is not resolved
+		{
+			this->ulTimer_Clock = this->Timer_Resolve_Frequency();
+		}
+		return this->ulTimer_Clock;
+	}
+
+	/**
+	  * @brief  This function clears the saved timer clock frequency. Call it after the RCC clocks are reconfigured.
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM::Invalidate_Timer_Clock(void)
+	{
+		this->ulTimer_Clock = 0;
+	}
+
+	/**
+	  * @brief  This function returns the timer frequency value according to microcontroller type.
+	  *			Timers of APB1 bus are listed in pxAPB1_Timers, other timers are connected to APB2 bus.
+	  *			If the APB prescaler is not 1, the timer clock is 2 times of the bus clock (4 times if TIMPRE is set).
+	  *			Supported series: STM32F0, F1, F2, F3, F4, F7, G0, G4, H7, L4. For other series it returns 0.
+	  * @param  None
+	  * @retval Timer Frequency according to Hz
+	  */
+	uint32_t Hardware_PWM::Timer_Resolve_Frequency(void)
+	{
+		uint32_t Bus_Frequency = 0;
+		uint32_t Frequency = 0;
+		bool Timer_Prescaler_Selection = false;
+
+#if defined(STM32F0) || defined(STM32G0)
+		/*All timers are connected to the APB bus clock*/
+		Bus_Frequency = HAL_RCC_GetPCLK1Freq();
+#elif defined(STM32F1) || defined(STM32F2) || defined(STM32F3) || defined(STM32F4) || defined(STM32F7) || \
+	  defined(STM32G4) || defined(STM32H7) || defined(STM32L4)
+		Bus_Frequency = HAL_RCC_GetPCLK2Freq();		//Default bus of timers
+		for (uint8_t i = 0; i < (sizeof(pxAPB1_Timers) / sizeof(pxAPB1_Timers[0])); i++)
+		{
+			if (this->pxTimer->Instance == pxAPB1_Timers[i])
+			{
+				Bus_Frequency = HAL_RCC_GetPCLK1Freq();
+				break;
+			}
+		}
+#else
+		return 0;	//The microcontroller series is not supported
+#endif
+
+#if defined(RCC_DCKCFGR_TIMPRE)
+		Timer_Prescaler_Selection = ((RCC->DCKCFGR & RCC_DCKCFGR_TIMPRE) != 0);
+#elif defined(RCC_DCKCFGR1_TIMPRE)
+		Timer_Prescaler_Selection = ((RCC->DCKCFGR1 & RCC_DCKCFGR1_TIMPRE) != 0);
+#elif defined(RCC_CFGR_TIMPRE)
+		Timer_Prescaler_Selection = ((RCC->CFGR & RCC_CFGR_TIMPRE) != 0);
+#endif
+
+		if (HAL_RCC_GetHCLKFreq() == Bus_Frequency)	//It means APB Prescaler = 1
+		{
+			Frequency = Bus_Frequency;
+		}
+		else if ((Timer_Prescaler_Selection == true) && ((HAL_RCC_GetHCLKFreq() / Bus_Frequency) >= 4))	//It means APB Prescaler >= 4 and TIMPRE = 1
+		{
+			Frequency = Bus_Frequency * 4;
+		}
+		else if (Timer_Prescaler_Selection == true)	//It means APB Prescaler = 2 and TIMPRE = 1
+		{
+			Frequency = HAL_RCC_GetHCLKFreq();
+		}
+		else	//It means APB Prescaler != 1
+		{
+			Frequency = Bus_Frequency * 2;
+		}
+
+		return Frequency;
+	}
+
+	/**
+	  * @brief  Constructor function of a group of synchronized timers
+	  * @param  _pxMaster: The timer which starts the other timers of group
+	  * @retval None
+	  */
+	Hardware_PWM_Group::Hardware_PWM_Group(Hardware_PWM* _pxMaster)
+	{
+		this->ucTimer_Count = 1;
+		this->xGroup_Running = false;
+		this->pxTimers[0] = _pxMaster;
+		for (uint8_t i = 0; i < HARDWARE_PWM_GROUP_SIZE; i++)
+		{
+			if (i != 0)
+			{
+				this->pxTimers[i] = NULL;
+			}
+			this->ulTimer_Phase[i] = 0;
+		}
+		this->pxTimers[0]->Timer_Config_Master();
+	}
+
+	/**
+	  * @brief  Destructor Function
+	  * @param  None
+	  * @retval None
+	  */
+	Hardware_PWM_Group::~Hardware_PWM_Group(void)
+	{
+
+	}
+
+	/**
+	  * @brief  This function adds a slave timer to the group.
+	  *			For chained groups (a slave which is the master of the next timers), configure it by another group.
+	  *			The period of slave should be the same as the master period. Its prescaler is derived from the master values
+	  *			(see Slave_Prescaler) and written to the slave, so the timers do not drift when their clocks are different.
+	  * @param  _pxSlave: The slave timer
+	  *			_ulInputTrigger: The internal trigger of slave which is connected to the master trigger output.
+	  *							 It can be TIM_TS_ITR0,1,2,3 according to the reference manual
+	  * @retval true if the timer is added. false if the group is full or the slave can not have the master period exactly
+	  */
+	bool Hardware_PWM_Group::Add_Slave(Hardware_PWM* _pxSlave, uint32_t _ulInputTrigger)
+	{
+		Hardware_PWM* Master = this->pxTimers[0];
+		uint64_t Prescaler = 0;
+
+		if (this->ucTimer_Count >= HARDWARE_PWM_GROUP_SIZE)	//The group is full
+		{
+			return false;
+		}
+		if (this->Slave_Prescaler(_pxSlave, Master->ulTimer_Prescaler, Master->ulTimer_Period, &Prescaler) == false)
+		{
+			return false;
+		}
+		if ((Prescaler != _pxSlave->ulTimer_Prescaler) || (Master->ulTimer_Period != _pxSlave->ulTimer_Period))
+		{
+			_pxSlave->Begin_Update();
+			_pxSlave->Frequency_Apply(Master->pxTimerSpecs_Data->_ulFrequency, Prescaler, Master->ulTimer_Period);
+			_pxSlave->End_Update();
+		}
+		_pxSlave->Timer_Config_Slave(_ulInputTrigger);
+		this->pxTimers[this->ucTimer_Count] = _pxSlave;
+		this->ucTimer_Count++;
+		return true;
+	}
+
+	/**
+	  * @brief  This function derives the prescaler of a slave from the master values. The period register is the same, and
+	  *			(slave prescaler + 1) = (master prescaler + 1) * slave clock / master clock should be an integer, so the period
+	  *			of both timers is the same number of nanoseconds.
+	  * @param  _pxSlave: The slave timer
+	  *			_ulPrescaler: The prescaler register value of master
+	  *			_ulPeriod: The Auto Reload Register value of master
+	  *			_pulSlave_Prescaler: The prescaler register value of slave
+	  * @retval false if the counter modes are different, or the values do not fit in the slave or are not exact
+	  */
+	bool Hardware_PWM_Group::Slave_Prescaler(Hardware_PWM* _pxSlave, uint64_t _ulPrescaler, uint32_t _ulPeriod, uint64_t* _pulSlave_Prescaler)
+	{
+		Hardware_PWM* Master = this->pxTimers[0];
+		uint64_t Master_Clock = Master->Timer_Get_Frequency();
+		uint64_t Slave_Clock = _pxSlave->Timer_Get_Frequency();
+		uint64_t Scaled = (_ulPrescaler + 1) * Slave_Clock;
+
+		if ((Master->Timer_Is_Center_Aligned() != _pxSlave->Timer_Is_Center_Aligned()) ||
+			((_pxSlave->pxTimerSpecs_Data->_xTimerIs32bit == false) && (_ulPeriod > 0xFFFF)) ||
+			(Master_Clock == 0) || ((Scaled % Master_Clock) != 0) || ((Scaled / Master_Clock) == 0) || ((Scaled / Master_Clock) > 0x10000))
+		{
+			return false;
+		}
+		*_pulSlave_Prescaler = (Scaled / Master_Clock) - 1;
+		return true;
+	}
+
+	/**
+	  * @brief  This function starts all channels of all timers with a dutycycle value.
+	  *			All counters are reset and started together by the master counter enable, so the timers are phase locked.
+	  * @param  _DutyCycle: Dutycycle value according to percent.
+	  * @retval None
+	  */
+	void Hardware_PWM_Group::Start_All_PWM(double _DutyCycle)
+	{
+		Hardware_PWM* Timer = NULL;
+		uint32_t Ticks[4];
+		uint64_t Counts = 0;
+
+		for (uint8_t i = 0; i < this->ucTimer_Count; i++)
+		{
+			Timer = this->pxTimers[i];
+			Counts = Timer->Timer_Counts();
+			Timer->pxTimer->Instance->CR1 &= ~TIM_CR1_CEN;		//Stop the counter
+			Timer->ulPhase_Stretch = 0;
+			for (uint8_t j = 0; j < 4; j++)
+			{
+				Ticks[j] = (uint32_t)(Timer->ulTimer_Period * (_DutyCycle / 100.0));
+			}
+			Timer->Set_All_DutyCycle_Ticks(Ticks);
+			Timer->pxTimer->Instance->EGR = TIM_EGR_UG;		//Load the preloaded registers. It clears the counter too
+			Timer->pxTimer->Instance->CNT = (uint32_t)((Counts - (this->ulTimer_Phase[i] % Counts)) % Counts);	//The counter preload makes the phase offset
+			Timer->pxTimer->Instance->CCER |= Timer->Channel_Enable_Mask(0x0F);	//Enable the outputs
+			Timer->ucChannel_Running = 0x0F;
+			Timer->Channel_HAL_State(0x0F, true);
+			if (IS_TIM_BREAK_INSTANCE(Timer->pxTimer->Instance) && (Timer->Get_Break_Status() == false))
+			{
+				Timer->pxTimer->Instance->BDTR |= TIM_BDTR_MOE;	//Main output enable
 			}
-			else	//It means APB2 Prescaler != 1
+		}
+		this->pxTimers[0]->pxTimer->Instance->CR1 |= TIM_CR1_CEN;	//The master trigger output starts the slaves
+		this->xGroup_Running = true;
+	}
+
+	/**
+	  * @brief  This function stops all channels of all timers
+	  * @param  None
+	  * @retval None
+	  */
+	void Hardware_PWM_Group::Stop_All_PWM(void)
+	{
+		for (uint8_t i = 0; i < this->ucTimer_Count; i++)
+		{
+			this->pxTimers[i]->Stop_All_PWM();
+		}
+		this->xGroup_Running = false;
+	}
+
+	/**
+	  * @brief  This function changes the dutycycle of all timers together. The values are loaded in the same update event.
+	  * @param  _ulTicks: Dutycycle values of channel 1,2,3,4 of each timer according to timer ticks
+	  * @retval None
+	  */
+	void Hardware_PWM_Group::Set_All_DutyCycle_Ticks(const uint32_t _ulTicks[][4])
+	{
+		for (uint8_t i = 0; i < this->ucTimer_Count; i++)
+		{
+			this->pxTimers[i]->Begin_Update();
+		}
+		for (uint8_t i = 0; i < this->ucTimer_Count; i++)
+		{
+			for (uint8_t j = 0; j < 4; j++)
 			{
-				Frequency = HAL_RCC_GetPCLK2Freq() * 2;
+				if (this->pxTimers[i]->Get_Channel_Mode(j) != Disable)
+				{
+					this->pxTimers[i]->Channel_Store_Compare(j, _ulTicks[i][j]);
+				}
 			}
 		}
+		for (uint8_t i = 0; i < this->ucTimer_Count; i++)
+		{
+			this->pxTimers[i]->End_Update();
+		}
+	}
 
-#endif
+	/**
+	  * @brief  This function changes the frequency of all timers together without stopping the outputs.
+	  *			The frequency is solved once for the master and the slave values are derived from it (see Slave_Prescaler),
+	  *			so all timers have the same period. The new values are loaded in the same update event and the dutycycles are kept.
+	  * @param  _ulNewFrequency: PWM frequency according to Hz
+	  * @retval true if the frequency is changed. false if the master can not generate it or a slave can not have the same
+	  *			period, and nothing is changed
+	  */
+	bool Hardware_PWM_Group::Change_Frequency(uint32_t _ulNewFrequency)
+	{
+		Hardware_PWM* Master = this->pxTimers[0];
+		uint64_t Prescaler[HARDWARE_PWM_GROUP_SIZE];
+		uint32_t Period = 0;
 
-#ifdef STM32F3
-		if (this->pxTimer->Instance == TIM2 || this->pxTimer->Instance == TIM3 || this->pxTimer->Instance == TIM4 ||
-			this->pxTimer->Instance == TIM6 || this->pxTimer->Instance == TIM7) //These timers are connected to the APB1 bus clock ==> Max = 36MHz
+		if (Master->Timer_Frequency_Is_Valid(_ulNewFrequency) == false)
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK1Freq())	//It means APB1 Prescaler = 1
+			return false;
+		}
+		Master->Timer_Solve(_ulNewFrequency, &Prescaler[0], &Period);
+		for (uint8_t i = 1; i < this->ucTimer_Count; i++)	//Check all slaves before any register is written
+		{
+			if (this->Slave_Prescaler(this->pxTimers[i], Prescaler[0], Period, &Prescaler[i]) == false)
 			{
-				Frequency = HAL_RCC_GetPCLK1Freq();
+				return false;
 			}
-			else	//It means APB1 Prescaler != 1
+		}
+
+		for (uint8_t i = 0; i < this->ucTimer_Count; i++)
+		{
+			this->pxTimers[i]->Begin_Update();
+		}
+		for (uint8_t i = 0; i < this->ucTimer_Count; i++)
+		{
+			this->pxTimers[i]->Frequency_Apply(_ulNewFrequency, Prescaler[i], Period);
+		}
+		for (uint8_t i = 0; i < this->ucTimer_Count; i++)
+		{
+			this->pxTimers[i]->End_Update();
+		}
+		return true;
+	}
+
+	/**
+	  * @brief  This function sets the phase of a timer in the group. The timer is delayed from the master timer by the phase.
+	  *			Before Start_All_PWM, the phase is applied by the counter preload. When the group is running, the timer is
+	  *			delayed by longer periods (the pulses are not cut), so Update_Event_Handler of the timer should be called
+	  *			in its update event.
+	  * @param  _ucTimer: The index of timer in the group. 0 is the master
+	  *			_ulPhase: Phase according to timer ticks
+	  * @retval None
+	  */
+	void Hardware_PWM_Group::Set_Phase_Ticks(uint8_t _ucTimer, uint32_t _ulPhase)
+	{
+		Hardware_PWM* Timer = NULL;
+		uint64_t Counts = 0;
+
+		if (_ucTimer >= this->ucTimer_Count)
+		{
+			return;
+		}
+		Timer = this->pxTimers[_ucTimer];
+		Counts = Timer->Timer_Counts();
+		_ulPhase = (uint32_t)(_ulPhase % Counts);
+
+		if (this->xGroup_Running == true)
+		{
+			Timer->pxTimer->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+			Timer->pxTimer->Instance->CR1 |= TIM_CR1_ARPE;	//The longer periods are loaded in the update events, so the running period is not cut
+			HARDWARE_PWM_ENTER_CRITICAL();	//Update_Event_Handler decreases it
+			Timer->ulPhase_Stretch += (uint32_t)((Counts + _ulPhase - this->ulTimer_Phase[_ucTimer]) % Counts);	//The extra delay
+			HARDWARE_PWM_EXIT_CRITICAL();
+			Timer->Update_Interrupt_Enable();	//It is disabled when the period is restored
+		}
+		this->ulTimer_Phase[_ucTimer] = _ulPhase;
+	}
+
+	/**
+	  * @brief  This function sets the phase of a timer in the group. See Set_Phase_Ticks
+	  * @param  _ucTimer: The index of timer in the group. 0 is the master
+	  *			_Phase: Phase according to degree
+	  * @retval None
+	  */
+	void Hardware_PWM_Group::Set_Phase_Degrees(uint8_t _ucTimer, double _Phase)
+	{
+		if (_ucTimer < this->ucTimer_Count)
+		{
+			this->Set_Phase_Ticks(_ucTimer, (uint32_t)(this->pxTimers[_ucTimer]->Timer_Counts() * (_Phase / 360.0)));
+		}
+	}
+
+	/**
+	  * @brief  Constructor function of software PWM channels.
+	  *			The timer should be initialized before (for example by Hardware_PWM class or CubeMX) in edge aligned mode.
+	  *			The compare channel is set to timing mode without preload, so a new compare value is used at once.
+	  * @param  _pxTimer: The address of timer handle variable
+	  *			_ucCompare_Channel: The compare channel which makes the interrupts. It can be TIM_CHANNEL_1,2,3,4
+	  *			_pxPins: The address of pin table. Channel n uses the pin n of the table
+	  *			_ucPin_Count: The number of pins. The extra pins and the pins of extra ports are not used
+	  * @retval None
+	  */
+	Software_PWM::Software_PWM(TIM_HandleTypeDef* _pxTimer, uint8_t _ucCompare_Channel, const Software_Pin_Type* _pxPins, uint8_t _ucPin_Count)
+	{
+		uint8_t Index = _ucCompare_Channel >> 2;	//TIM_CHANNEL_x values are 0, 4, 8, 12
+		uint8_t Port = 0;
+
+		this->pxTimer = _pxTimer;
+		this->pxPWM = NULL;
+		this->ucCompare_Index = Index;
+		this->pulCompare = &_pxTimer->Instance->CCR1 + Index;
+		this->ulCompare_Flag = TIM_SR_CC1IF << Index;
+		this->ucPort_Count = 0;
+		this->ucChannel_Count = 0;
+		this->ulChannel_Running = 0;
+		this->ucSchedule_Active = 0;
+		this->ucSchedule_Latest = 0;
+		this->xSchedule_Pending = false;
+		this->ucSlot = 0;
+		for (uint8_t i = 0; i < 2; i++)
+		{
+			this->xSchedule[i].ucSlots = 1;
+			this->xSchedule[i].xSlots[0].ulTick = 0;
+			for (uint8_t j = 0; j < SOFTWARE_PWM_PORTS; j++)
 			{
-				Frequency = HAL_RCC_GetPCLK1Freq() * 2;
+				this->xSchedule[i].xSlots[0].ulBSRR[j] = 0;
 			}
 		}
-		else	//These timers are connected to the APB2 bus clock ==> Max = 72MHz
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+		HARDWARE_PWM_CYCLE_COUNTER_INIT();
+		this->Reset_Statistics();
+#endif
+
+		for (uint8_t i = 0; (i < _ucPin_Count) && (this->ucChannel_Count < SOFTWARE_PWM_CHANNELS); i++)
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK2Freq())	//It means APB2 Prescaler = 1
+			for (Port = 0; Port < this->ucPort_Count; Port++)	//Find the port of pin
+			{
+				if (this->pxPorts[Port] == _pxPins[i]._pxPort)
+				{
+					break;
+				}
+			}
+			if (Port == this->ucPort_Count)	//A new port
 			{
-				Frequency = HAL_RCC_GetPCLK2Freq();
+				if (this->ucPort_Count >= SOFTWARE_PWM_PORTS)
+				{
+					continue;
+				}
+				this->pxPorts[this->ucPort_Count] = _pxPins[i]._pxPort;
+				this->ucPort_Count++;
 			}
-			else	//It means APB2 Prescaler != 1
+			this->ucChannel_Port[this->ucChannel_Count] = Port;
+			this->usChannel_Pin[this->ucChannel_Count] = _pxPins[i]._usPin;
+			this->ulChannel_DutyCycle[this->ucChannel_Count] = 0;
+			this->ulChannel_Ticks[this->ucChannel_Count] = 0;
+			this->pxPorts[Port]->BSRR = (uint32_t)_pxPins[i]._usPin << 16;	//The pin is low
+			this->ucChannel_Count++;
+		}
+
+		__HAL_TIM_DISABLE_IT(this->pxTimer, TIM_IT_CC1 << Index);
+		this->Compare_Config();
+		this->ulTimer_Counts = this->pxTimer->Instance->ARR + 1;
+	}
+
+	/**
+	  * @brief  Constructor function of software PWM channels on the timer of a Hardware_PWM object. The object keeps the
+	  *			counter running for the software channels, does not clear the compare channel and scales the edges after
+	  *			Change_Frequency and Change_Frequency_Seamless. Only one Software_PWM object can be attached to a timer.
+	  * @param  _pxPWM: The address of Hardware_PWM object. It should be created before
+	  *			_ucCompare_Channel: The compare channel which makes the interrupts. It can be TIM_CHANNEL_1,2,3,4 and
+	  *								it should be Disable in PWM_Channels
+	  *			_pxPins: The address of pin table. Channel n uses the pin n of the table
+	  *			_ucPin_Count: The number of pins. The extra pins and the pins of extra ports are not used
+	  * @retval None
+	  */
+	Software_PWM::Software_PWM(Hardware_PWM* _pxPWM, uint8_t _ucCompare_Channel, const Software_Pin_Type* _pxPins, uint8_t _ucPin_Count)
+		: Software_PWM(_pxPWM->pxTimer, _ucCompare_Channel, _pxPins, _ucPin_Count)
+	{
+		if ((_pxPWM->Get_Channel_Mode(this->ucCompare_Index) != Disable) || (_pxPWM->pxSoftware != NULL))	//The compare channel is used
+		{
+			Error_Handler();
+			return;
+		}
+		this->pxPWM = _pxPWM;
+		_pxPWM->pxSoftware = this;
+	}
+
+	/**
+	  * @brief  Destructor Function
+	  * @param  None
+	  * @retval None
+	  */
+	Software_PWM::~Software_PWM(void)
+	{
+		__HAL_TIM_DISABLE_IT(this->pxTimer, this->ulCompare_Flag);	//The compare interrupt should not call a destroyed object
+		if (this->pxPWM != NULL)
+		{
+			this->pxPWM->pxSoftware = NULL;
+		}
+	}
+
+	/**
+	  * @brief  This function starts a software PWM channel. The new dutycycle is used from the next period.
+	  * @param  _ucChannel: The channel number. It is the index of pin in the pin table
+	  *			_DutyCycle: Dutycycle value according to percent.
+	  * @retval None
+	  */
+	void Software_PWM::Start_PWM(uint8_t _ucChannel, double _DutyCycle)
+	{
+		Software_Schedule_Type* Schedule = NULL;
+
+		if (_ucChannel < this->ucChannel_Count)
+		{
+			Schedule = this->Schedule_Begin();
+			this->Channel_Update(Schedule, _ucChannel, (uint32_t)((65536.0 * (_DutyCycle / 100.0)) + 0.5), true);
+			this->Schedule_Commit();
+			this->Timer_Start();
+		}
+	}
+
+	/**
+	  * @brief  This function stops a software PWM channel. The pin is low at once.
+	  * @param  _ucChannel: The channel number. It is the index of pin in the pin table
+	  * @retval None
+	  */
+	void Software_PWM::Stop_PWM(uint8_t _ucChannel)
+	{
+		Software_Schedule_Type* Schedule = NULL;
+
+		if ((_ucChannel < this->ucChannel_Count) && ((this->ulChannel_Running & (1UL << _ucChannel)) != 0))
+		{
+			Schedule = this->Schedule_Begin();
+			this->Channel_Update(Schedule, _ucChannel, this->ulChannel_DutyCycle[_ucChannel], false);
+			this->Schedule_Commit();
+			this->pxPorts[this->ucChannel_Port[_ucChannel]]->BSRR = (uint32_t)this->usChannel_Pin[_ucChannel] << 16;	//The current pulse is cut
+			if (this->ulChannel_Running == 0)	//The interrupt is not needed
 			{
-				Frequency = HAL_RCC_GetPCLK2Freq() * 2;
+				__HAL_TIM_DISABLE_IT(this->pxTimer, this->ulCompare_Flag);	//TIM_IT_CCx and TIM_SR_CCxIF are the same bits
 			}
 		}
+	}
+
+	/**
+	  * @brief  This function starts all software PWM channels with a dutycycle value. All channels start in the same period.
+	  * @param  _DutyCycle: Dutycycle value according to percent.
+	  * @retval None
+	  */
+	void Software_PWM::Start_All_PWM(double _DutyCycle)
+	{
+		Software_Schedule_Type* Schedule = this->Schedule_Begin();
+		uint32_t DutyCycle = (uint32_t)((65536.0 * (_DutyCycle / 100.0)) + 0.5);
+
+		for (uint8_t i = 0; i < this->ucChannel_Count; i++)
+		{
+			this->Channel_Update(Schedule, i, DutyCycle, true);
+		}
+		this->Schedule_Commit();
+		this->Timer_Start();
+	}
+
+	/**
+	  * @brief  This function stops all software PWM channels. The pins of each port are cleared by one register write.
+	  * @param  None
+	  * @retval None
+	  */
+	void Software_PWM::Stop_All_PWM(void)
+	{
+		Software_Schedule_Type* Schedule = this->Schedule_Begin();
+		uint32_t Reset[SOFTWARE_PWM_PORTS] = { 0 };
+
+		for (uint8_t i = 0; i < this->ucChannel_Count; i++)
+		{
+			this->Channel_Update(Schedule, i, this->ulChannel_DutyCycle[i], false);
+			Reset[this->ucChannel_Port[i]] |= (uint32_t)this->usChannel_Pin[i] << 16;
+		}
+		this->Schedule_Commit();
+		__HAL_TIM_DISABLE_IT(this->pxTimer, this->ulCompare_Flag);
+		for (uint8_t i = 0; i < this->ucPort_Count; i++)
+		{
+			this->pxPorts[i]->BSRR = Reset[i];
+		}
+	}
+
+	/**
+	  * @brief  This function changes the dutycycle of a software PWM channel
+	  * @param  _ucChannel: The channel number. It is the index of pin in the pin table
+	  *			_DutyCycle: Dutycycle value according to percent.
+	  * @retval None
+	  */
+	void Software_PWM::Change_DutyCycle(uint8_t _ucChannel, double _DutyCycle)
+	{
+		this->Start_PWM(_ucChannel, _DutyCycle);
+	}
+
+	/**
+	  * @brief  This function reads the timer period again and scales all edges. Call it after the timer frequency is changed
+	  *			(an attached Hardware_PWM object calls it). The interrupt is moved to the start of next period, so an edge of
+	  *			the old period is not waited after the counter is reloaded. The current period can be longer.
+	  * @param  None
+	  * @retval None
+	  */
+	void Software_PWM::Update_Period(void)
+	{
+		Software_Schedule_Type* Schedule = this->Schedule_Begin();
+		uint32_t Running = this->ulChannel_Running;
+
+		for (uint8_t i = 0; i < this->ucChannel_Count; i++)	//Remove the edges of old period
+		{
+			this->Channel_Update(Schedule, i, this->ulChannel_DutyCycle[i], false);
+		}
+		this->ulTimer_Counts = this->pxTimer->Instance->ARR + 1;
+		for (uint8_t i = 0; i < this->ucChannel_Count; i++)
+		{
+			this->Channel_Update(Schedule, i, this->ulChannel_DutyCycle[i], ((Running & (1UL << i)) != 0));
+		}
+		this->Schedule_Commit();
+		this->Timer_Resync();
+	}
+
+	/**
+	  * @brief  This function returns the number of software PWM channels
+	  * @param  None
+	  * @retval The number of channels
+	  */
+	uint8_t Software_PWM::Get_Channel_Count(void)
+	{
+		return this->ucChannel_Count;
+	}
 
+	/**
+	  * @brief  This function writes the pins of the current slot and loads the compare value of the next slot.
+	  *			Call it in the compare interrupt of timer. For the lowest jitter, call it directly in TIMx_CC_IRQHandler
+	  *			instead of HAL_TIM_OC_DelayElapsedCallback. The edited schedule is used from slot 0, so each period is
+	  *			played from one schedule. If the next edge is closer than SOFTWARE_PWM_LATENCY ticks or it is passed,
+	  *			it is written in this interrupt too. The flag is cleared after the next compare value is written, so the
+	  *			match of the old value does not make an extra interrupt.
+	  * @param  None
+	  * @retval None
+	  */
+	void Software_PWM::Compare_Event_Handler(void)
+	{
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+		Instrument_Probe xInstrument_Probe(&this->xStatistics);
 #endif
+		TIM_TypeDef* Timer = this->pxTimer->Instance;
+		const Software_Schedule_Type* Schedule = &this->xSchedule[this->ucSchedule_Active];
+		const Software_Slot_Type* Current = NULL;
+		uint8_t Slot = this->ucSlot;
+		uint32_t Next = 0;
 
-#ifdef STM32F4
-		if (this->pxTimer->Instance == TIM2 || this->pxTimer->Instance == TIM3 || this->pxTimer->Instance == TIM4 ||
-			this->pxTimer->Instance == TIM5 || this->pxTimer->Instance == TIM6 || this->pxTimer->Instance == TIM7 ||
-			this->pxTimer->Instance == TIM12 || this->pxTimer->Instance == TIM13 || this->pxTimer->Instance == TIM14) //These timers are connected to the APB1 bus clock ==> Max = 42MHz
+		do
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK1Freq())	//It means APB1 Prescaler = 1
+			if ((Slot == 0) && (this->xSchedule_Pending == true))	//Switch the schedules at the start of period
+			{
+				this->ucSchedule_Active ^= 1;
+				this->xSchedule_Pending = false;
+				Schedule = &this->xSchedule[this->ucSchedule_Active];
+			}
+			Current = &Schedule->xSlots[Slot];
+			for (uint8_t i = 0; i < this->ucPort_Count; i++)
+			{
+				if (Current->ulBSRR[i] != 0)
+				{
+					this->pxPorts[i]->BSRR = Current->ulBSRR[i];	//All edges of the port in one store
+				}
+			}
+
+			Slot++;
+			if (Slot >= Schedule->ucSlots)
 			{
-				Frequency = HAL_RCC_GetPCLK1Freq();
+				Slot = 0;
 			}
-			else	//It means APB1 Prescaler != 1
+			Next = Schedule->xSlots[Slot].ulTick;
+			*this->pulCompare = Next;
+			Timer->SR = ~this->ulCompare_Flag;	//The match of this slot is handled. The other flags are not changed (rc_w0)
+		} while ((Slot != 0) && ((Timer->CNT + SOFTWARE_PWM_LATENCY) >= Next));	//Slot 0 matches after the counter is reloaded
+		this->ucSlot = Slot;
+	}
+
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+	/**
+	  * @brief  This function returns the execution time statistics of Compare_Event_Handler. Start the same number of
+	  *			channels with different dutycycles to measure the interrupt cost against the channel count.
+	  * @param  None
+	  * @retval The address of statistics
+	  */
+	const Probe_Statistics_Type* Software_PWM::Get_Statistics(void)
+	{
+		return &this->xStatistics;
+	}
+
+	/**
+	  * @brief  This function clears the execution time statistics
+	  * @param  None
+	  * @retval None
+	  */
+	void Software_PWM::Reset_Statistics(void)
+	{
+		this->xStatistics.ulCalls = 0;
+		this->xStatistics.ulMin = 0;
+		this->xStatistics.ulMax = 0;
+		for (uint8_t i = 0; i < HARDWARE_PWM_HISTOGRAM_BINS; i++)
+		{
+			this->xStatistics.ulHistogram[i] = 0;
+		}
+	}
+#endif
+
+	/**
+	  * @brief  This function returns the schedule which can be edited. The interrupt does not switch the schedules
+	  *			until Schedule_Commit. If the interrupt played the last edited schedule, it is copied before.
+	  * @param  None
+	  * @retval The address of schedule
+	  */
+	Software_Schedule_Type* Software_PWM::Schedule_Begin(void)
+	{
+		uint8_t Shadow = 0;
+
+		this->xSchedule_Pending = false;
+		Shadow = this->ucSchedule_Active ^ 1;
+		if (this->ucSchedule_Latest != Shadow)	//The other schedule is old
+		{
+			const Software_Schedule_Type* Source = &this->xSchedule[this->ucSchedule_Active];
+
+			this->xSchedule[Shadow].ucSlots = Source->ucSlots;
+			for (uint8_t i = 0; i < Source->ucSlots; i++)
 			{
-				Frequency = HAL_RCC_GetPCLK1Freq() * 2;
+				this->xSchedule[Shadow].xSlots[i] = Source->xSlots[i];
 			}
 		}
-		else	//These timers are connected to the APB2 bus clock ==> Max = 84MHz
+		return &this->xSchedule[Shadow];
+	}
+
+	/**
+	  * @brief  This function gives the edited schedule to the interrupt. It is played from the next period.
+	  * @param  None
+	  * @retval None
+	  */
+	void Software_PWM::Schedule_Commit(void)
+	{
+		this->ucSchedule_Latest = this->ucSchedule_Active ^ 1;
+		this->xSchedule_Pending = true;
+	}
+
+	/**
+	  * @brief  This function finds the first edge slot which is not before a tick value by binary search
+	  * @param  _pxSchedule: The address of schedule
+	  *			_ulTick: Counter value
+	  * @retval Slot index. It is the number of slots if all slots are before the tick value
+	  */
+	uint8_t Software_PWM::Schedule_Find(const Software_Schedule_Type* _pxSchedule, uint32_t _ulTick)
+	{
+		uint8_t Low = 1;	//Slot 0 is not an edge slot
+		uint8_t High = _pxSchedule->ucSlots;
+		uint8_t Middle = 0;
+
+		while (Low < High)
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK2Freq())	//It means APB2 Prescaler = 1
+			Middle = (uint8_t)((Low + High) / 2);
+			if (_pxSchedule->xSlots[Middle].ulTick < _ulTick)
 			{
-				Frequency = HAL_RCC_GetPCLK2Freq();
+				Low = Middle + 1;
 			}
-			else	//It means APB2 Prescaler != 1
+			else
 			{
-				Frequency = HAL_RCC_GetPCLK2Freq() * 2;
+				High = Middle;
 			}
 		}
+		return Low;
+	}
 
-#endif
+	/**
+	  * @brief  This function removes the edges of a channel from a schedule. An empty slot is removed.
+	  * @param  _pxSchedule: The address of schedule
+	  *			_ucChannel: The channel number
+	  * @retval None
+	  */
+	void Software_PWM::Schedule_Remove(Software_Schedule_Type* _pxSchedule, uint8_t _ucChannel)
+	{
+		uint8_t Port = this->ucChannel_Port[_ucChannel];
+		uint32_t Pin = this->usChannel_Pin[_ucChannel];
+		uint32_t Ticks = this->ulChannel_Ticks[_ucChannel];
+		uint8_t Slot = 0;
+		bool Empty = true;
+
+		if ((this->ulChannel_Running & (1UL << _ucChannel)) == 0)	//The channel has no edge
+		{
+			return;
+		}
+		_pxSchedule->xSlots[0].ulBSRR[Port] &= ~Pin;
+		if ((Ticks == 0) || (Ticks >= this->ulTimer_Counts))	//No falling edge
+		{
+			return;
+		}
 
-#ifdef STM32F7
-		if (this->pxTimer->Instance == TIM2 || this->pxTimer->Instance == TIM3 || this->pxTimer->Instance == TIM4 ||
-			this->pxTimer->Instance == TIM5 || this->pxTimer->Instance == TIM6 || this->pxTimer->Instance == TIM7 ||
-			this->pxTimer->Instance == TIM12 || this->pxTimer->Instance == TIM13 || this->pxTimer->Instance == TIM14) //These timers are connected to the APB1 bus clock ==> Max = 54MHz
+		Slot = this->Schedule_Find(_pxSchedule, Ticks);
+		if ((Slot < _pxSchedule->ucSlots) && (_pxSchedule->xSlots[Slot].ulTick == Ticks))
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK1Freq())	//It means APB1 Prescaler = 1
+			_pxSchedule->xSlots[Slot].ulBSRR[Port] &= ~(Pin << 16);
+			for (uint8_t i = 0; i < this->ucPort_Count; i++)
 			{
-				Frequency = HAL_RCC_GetPCLK1Freq();
+				if (_pxSchedule->xSlots[Slot].ulBSRR[i] != 0)
+				{
+					Empty = false;
+				}
 			}
-			else	//It means APB1 Prescaler != 1
+			if (Empty == true)
 			{
-				Frequency = HAL_RCC_GetPCLK1Freq() * 2;
+				for (uint8_t i = Slot; (i + 1) < _pxSchedule->ucSlots; i++)
+				{
+					_pxSchedule->xSlots[i] = _pxSchedule->xSlots[i + 1];
+				}
+				_pxSchedule->ucSlots--;
 			}
 		}
-		else	//These timers are connected to the APB2 bus clock ==> Max = 108MHz
+	}
+
+	/**
+	  * @brief  This function adds the edges of a channel to a schedule. The channels with the same dutycycle share a slot.
+	  * @param  _pxSchedule: The address of schedule
+	  *			_ucChannel: The channel number
+	  * @retval None
+	  */
+	void Software_PWM::Schedule_Insert(Software_Schedule_Type* _pxSchedule, uint8_t _ucChannel)
+	{
+		uint8_t Port = this->ucChannel_Port[_ucChannel];
+		uint32_t Pin = this->usChannel_Pin[_ucChannel];
+		uint32_t Ticks = this->ulChannel_Ticks[_ucChannel];
+		uint8_t Slot = 0;
+
+		if (((this->ulChannel_Running & (1UL << _ucChannel)) == 0) || (Ticks == 0))	//The pin is always low
+		{
+			return;
+		}
+		_pxSchedule->xSlots[0].ulBSRR[Port] |= Pin;
+		if (Ticks >= this->ulTimer_Counts)	//The pin is always high
+		{
+			return;
+		}
+
+		Slot = this->Schedule_Find(_pxSchedule, Ticks);
+		if ((Slot == _pxSchedule->ucSlots) || (_pxSchedule->xSlots[Slot].ulTick != Ticks))	//A new slot
 		{
-			if (HAL_RCC_GetHCLKFreq() == HAL_RCC_GetPCLK2Freq())	//It means APB2 Prescaler = 1
+			for (uint8_t i = _pxSchedule->ucSlots; i > Slot; i--)
 			{
-				Frequency = HAL_RCC_GetPCLK2Freq();
+				_pxSchedule->xSlots[i] = _pxSchedule->xSlots[i - 1];
 			}
-			else	//It means APB2 Prescaler != 1
+			_pxSchedule->ucSlots++;
+			_pxSchedule->xSlots[Slot].ulTick = Ticks;
+			for (uint8_t i = 0; i < SOFTWARE_PWM_PORTS; i++)
 			{
-				Frequency = HAL_RCC_GetPCLK2Freq() * 2;
+				_pxSchedule->xSlots[Slot].ulBSRR[i] = 0;
 			}
 		}
+		_pxSchedule->xSlots[Slot].ulBSRR[Port] |= Pin << 16;
+	}
 
-#endif
-		return Frequency;
+	/**
+	  * @brief  This function moves the edges of a channel in a schedule
+	  * @param  _pxSchedule: The address of schedule
+	  *			_ucChannel: The channel number
+	  *			_ulDutyCycle: Dutycycle value in Q16 format. 0x10000 means 100%
+	  *			_xRunning: true if the channel is started
+	  * @retval None
+	  */
+	void Software_PWM::Channel_Update(Software_Schedule_Type* _pxSchedule, uint8_t _ucChannel, uint32_t _ulDutyCycle, bool _xRunning)
+	{
+		if (_ulDutyCycle > 0x10000)
+		{
+			_ulDutyCycle = 0x10000;
+		}
+		this->Schedule_Remove(_pxSchedule, _ucChannel);
+		this->ulChannel_DutyCycle[_ucChannel] = _ulDutyCycle;
+		this->ulChannel_Ticks[_ucChannel] = (uint32_t)(((uint64_t)this->ulTimer_Counts * _ulDutyCycle) >> 16);
+		if (_xRunning == true)
+		{
+			this->ulChannel_Running |= (1UL << _ucChannel);
+		}
+		else
+		{
+			this->ulChannel_Running &= ~(1UL << _ucChannel);
+		}
+		this->Schedule_Insert(_pxSchedule, _ucChannel);
+	}
+
+	/**
+	  * @brief  This function sets the compare channel to timing mode without preload, so a new compare value is used at once
+	  * @param  None
+	  * @retval None
+	  */
+	void Software_PWM::Compare_Config(void)
+	{
+		Register_Type* CCMR = (this->ucCompare_Index < 2) ? &this->pxTimer->Instance->CCMR1 : &this->pxTimer->Instance->CCMR2;
+		uint32_t Shift = (this->ucCompare_Index & 1) * 8;	//Channel 2 and 4 use the second byte
+
+		MODIFY_REG(*CCMR, (TIM_CCMR1_OC1M | TIM_CCMR1_OC1PE) << Shift, TIM_OCMODE_TIMING << Shift);
+	}
+
+	/**
+	  * @brief  This function enables the compare interrupt if it is disabled. The first interrupt is at counter = 0.
+	  * @param  None
+	  * @retval None
+	  */
+	void Software_PWM::Timer_Start(void)
+	{
+		if (__HAL_TIM_GET_IT_SOURCE(this->pxTimer, this->ulCompare_Flag) == RESET)
+		{
+			this->ucSlot = 0;
+			*this->pulCompare = 0;
+			this->pxTimer->Instance->SR = ~this->ulCompare_Flag;
+			__HAL_TIM_ENABLE_IT(this->pxTimer, this->ulCompare_Flag);
+			this->pxTimer->Instance->CR1 |= TIM_CR1_CEN;	//Enable the counter
+		}
+	}
+
+	/**
+	  * @brief  This function moves the interrupt of a running schedule to the start of next period. The edited schedule
+	  *			is used from there.
+	  * @param  None
+	  * @retval None
+	  */
+	void Software_PWM::Timer_Resync(void)
+	{
+		if (__HAL_TIM_GET_IT_SOURCE(this->pxTimer, this->ulCompare_Flag) != RESET)
+		{
+			HARDWARE_PWM_ENTER_CRITICAL();
+			this->ucSlot = 0;
+			*this->pulCompare = 0;
+			this->pxTimer->Instance->SR = ~this->ulCompare_Flag;
+			HARDWARE_PWM_EXIT_CRITICAL();
+		}
 	}
 }
 /*****************************END OF FILE*****************************/
\ No newline at end of file
@@ -16,9 +16,81 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include <type_traits>
 
 /* Macros --------------------------------------------------------------------*/
+#ifndef HARDWARE_PWM_INSTRUMENTATION
+#define HARDWARE_PWM_INSTRUMENTATION	0	//Set it to 1 to measure the execution time of functions
+#endif
+
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+#ifndef HARDWARE_PWM_CYCLE_COUNTER	//Define it before this file to use another counter, for example a mock counter in host tests
+#if defined(HARDWARE_PWM_HOST) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define HARDWARE_PWM_CYCLE_COUNTER()		((uint32_t)__rdtsc())
+#elif defined(HARDWARE_PWM_HOST)
+#include <time.h>
+static inline uint32_t Hardware_PWM_Host_Counter(void)
+{
+	struct timespec Time;
+
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+	return (uint32_t)(((uint64_t)Time.tv_sec * 1000000000ULL) + Time.tv_nsec);	//According to nS
+}
+#define HARDWARE_PWM_CYCLE_COUNTER()		Hardware_PWM_Host_Counter()
+#elif (__CORTEX_M >= 3)
+#define HARDWARE_PWM_CYCLE_COUNTER()		(DWT->CYCCNT)
+#define HARDWARE_PWM_CYCLE_COUNTER_INIT()	do { CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; } while (0)
+#else
+#error "This core has no DWT cycle counter. Define HARDWARE_PWM_CYCLE_COUNTER() before including Hardware_PWM.hpp"
+#endif
+#endif
+#ifndef HARDWARE_PWM_CYCLE_COUNTER_INIT
+#define HARDWARE_PWM_CYCLE_COUNTER_INIT()
+#endif
+#define HARDWARE_PWM_PROBE(_xProbe)		Instrument_Probe xInstrument_Probe(&this->xStatistics.xProbes[_xProbe])
+#define HARDWARE_PWM_COUNT(_xCounter, _ulValue)	(this->xStatistics._xCounter += (_ulValue))
+#else
+#define HARDWARE_PWM_PROBE(_xProbe)
+#define HARDWARE_PWM_COUNT(_xCounter, _ulValue)
+#endif
+
+#ifndef HARDWARE_PWM_ENTER_CRITICAL	//Define both macros before this file to use the critical section of an RTOS
+#define HARDWARE_PWM_ENTER_CRITICAL()	uint32_t ulHardware_PWM_Primask = __get_PRIMASK(); __disable_irq()
+#define HARDWARE_PWM_EXIT_CRITICAL()	__set_PRIMASK(ulHardware_PWM_Primask)
+#endif
+
 /* Constants -----------------------------------------------------------------*/
+#define HARDWARE_PWM_BACKEND_HAL	0	//Start, stop and frequency functions use HAL functions
+#define HARDWARE_PWM_BACKEND_LL		1	//Start, stop and frequency functions access the timer registers directly
+
+#ifndef HARDWARE_PWM_BACKEND
+#define HARDWARE_PWM_BACKEND		HARDWARE_PWM_BACKEND_LL
+#endif
+
+#ifndef HARDWARE_PWM_GROUP_SIZE
+#define HARDWARE_PWM_GROUP_SIZE		4	//The maximum number of timers in a synchronized group
+#endif
+
+#ifndef HARDWARE_PWM_DMA_TIMERS
+#define HARDWARE_PWM_DMA_TIMERS		4	//The maximum number of timers which use the update DMA request (streaming, spread spectrum, ramp) at the same time
+#endif
+
+#ifndef SOFTWARE_PWM_CHANNELS
+#define SOFTWARE_PWM_CHANNELS		16	//The maximum number of software PWM channels of a timer. It can be 1 to 32
+#endif
+
+#ifndef SOFTWARE_PWM_PORTS
+#define SOFTWARE_PWM_PORTS			4	//The maximum number of GPIO ports which are used by software PWM channels of a timer
+#endif
+
+#ifndef SOFTWARE_PWM_LATENCY
+#define SOFTWARE_PWM_LATENCY		8	//Edges closer than this value (timer ticks) are written in the current interrupt
+#endif
+
+#ifndef HARDWARE_PWM_HISTOGRAM_BINS
+#define HARDWARE_PWM_HISTOGRAM_BINS	16	//Bin n counts the calls of 2^n to 2^(n+1)-1 cycles. The last bin counts longer calls too
+#endif
 
 /**
   * @brief  Hardware PWM controller Class. Version 1
@@ -26,11 +98,15 @@
 namespace Hardware_PWM_Ver1
 {
 	/* Types ---------------------------------------------------------------------*/
+	typedef decltype(TIM_TypeDef::CCR1) Register_Type;	//The type of timer registers. It is volatile uint32_t on the target and a register model in host builds
+
 	typedef struct
 	{
 		uint32_t _ulFrequency;
 		bool _xTimerIs32bit;	//This variable specifies the used timer is 32 bit or 16 bit
 		uint32_t _ulDeadTime;	//This variable saves the deadtime value according to nS
+		uint32_t _ulCounterMode;	//This variable saves the counter mode. It can be TIM_COUNTERMODE_UP (default) or TIM_COUNTERMODE_CENTERALIGNED1,2,3
+		uint32_t _ulRepetitionCounter;	//This variable saves the repetition counter value. The update event is generated after (value + 1) counter overflows/underflows
 	}TimerSpecs_Type;
 
 	typedef enum
@@ -48,8 +124,329 @@ namespace Hardware_PWM_Ver1
 		Channel_ModeType Channel4;
 	}PWM_Channels;
 
+	typedef enum
+	{
+		IdleMode = 0,
+		StreamMode,
+		SpreadSpectrumMode,
+		RampMode
+	}DMA_ModeType;
+
+	typedef enum
+	{
+		TriangleProfile = 0,
+		RandomProfile
+	}Spread_ProfileType;
+
+	typedef enum
+	{
+		LinearRamp = 0,
+		SCurveRamp,			//Smooth start and smooth end (smoothstep)
+		ExponentialRamp		//Fast start and slow end, like a first order system with time constant of ramp time / 5
+	}Ramp_ShapeType;
+
+	typedef void (*Stream_Callback_Type)(uint32_t* _pulFrames, uint16_t _usFrameCount, void* _pvContext);	//Fills frames of CCR1,CCR2,CCR3,CCR4 values
+
+	typedef struct
+	{
+		uint32_t ulPhase;	//Phase of the output signal. 0x100000000 means 360 degrees
+		uint32_t ulStep;	//This value is added to the phase in each step
+	}Phase_Accumulator_Type;
+
+	typedef struct
+	{
+		uint32_t _ulPeriod;		//This variable saves the Auto Reload Register value of pulses in this segment
+		uint32_t _ulPulses;		//This variable saves the number of pulses in this segment
+	}Pulse_Segment_Type;
+
+	typedef struct
+	{
+		uint32_t _ulPrescaler;		//The prescaler register value
+		uint32_t _ulPeriod;			//The Auto Reload Register value
+		uint32_t _ulFrequency;		//The posted frequency according to Hz
+		double _Frequency;			//The frequency which is generated by the timer
+		uint64_t _ulCounts;			//The number of timer ticks which is the 100% dutycycle
+		uint32_t _ulCompare[4];		//The Capture Compare Register values of channel 1,2,3,4
+	}Command_Record_Type;
+
+	typedef enum
+	{
+		TriggerPosition = 0,	//A fixed position in the period
+		TriggerHighCenter,		//The center of active time of the reference channel (high side on-time)
+		TriggerLowCenter		//The center of inactive time of the reference channel (low side on-time)
+	}Trigger_AnchorType;
+
+	typedef struct
+	{
+		uint8_t _ucChannel;				//The compare channel which makes the trigger. It can be TIM_CHANNEL_1,2,3,4 and it should be Disable in PWM_Channels
+		Trigger_AnchorType _xAnchor;	//The point of period which the trigger follows
+		uint8_t _ucReference;			//The channel which the center anchors follow. It can be TIM_CHANNEL_1,2,3,4
+		uint32_t _ulPosition;			//The position of TriggerPosition in Q16 format. 0x10000 means the whole period
+		int32_t _lOffset;				//This value is added to the trigger point according to timer ticks, for example to skip the switching noise
+	}ADC_Trigger_Type;
+
+	typedef struct
+	{
+		uint32_t _ulBreakState;			//It can be TIM_BREAK_ENABLE or TIM_BREAK_DISABLE (BKIN)
+		uint32_t _ulBreakPolarity;		//It can be TIM_BREAKPOLARITY_LOW or TIM_BREAKPOLARITY_HIGH
+		uint32_t _ulBreakFilter;		//Digital filter of break input. It can be 0 to 15 and it is used if the timer has the filter
+		uint32_t _ulBreak2State;		//It can be TIM_BREAK2_ENABLE or TIM_BREAK2_DISABLE (BKIN2). It is used if the timer has BKIN2
+		uint32_t _ulBreak2Polarity;		//It can be TIM_BREAK2POLARITY_LOW or TIM_BREAK2POLARITY_HIGH
+		uint32_t _ulBreak2Filter;		//Digital filter of the second break input. It can be 0 to 15
+		uint32_t _ulOffStateRunMode;	//It can be TIM_OSSR_ENABLE (outputs are driven to idle states) or TIM_OSSR_DISABLE (outputs are released)
+		uint32_t _ulOffStateIdleMode;	//It can be TIM_OSSI_ENABLE or TIM_OSSI_DISABLE
+		uint8_t _ucIdleStates;			//Bit 0 to bit 6 are OIS1, OIS1N, OIS2, OIS2N, OIS3, OIS3N, OIS4. 1 means the output is active in idle state
+		uint32_t _ulLockLevel;			//It can be TIM_LOCKLEVEL_OFF,1,2,3. The lock level can be written only once after reset
+		uint32_t _ulAutomaticOutput;	//It can be TIM_AUTOMATICOUTPUT_ENABLE (outputs are enabled in the next update event after the break) or TIM_AUTOMATICOUTPUT_DISABLE
+		bool _xInterrupt;				//true to enable the break interrupt, so HAL_TIMEx_BreakCallback is called
+	}Break_Config_Type;
+
+	typedef struct
+	{
+		uint64_t ulRise;	//The rising edge time according to timer clocks from the start of period (counter = 0)
+		uint64_t ulWidth;	//The active time according to timer clocks. 0 means always inactive and the period means always active
+	}Output_Edge_Type;
+
+	typedef struct
+	{
+		uint32_t ulClock;				//The timer clock frequency according to Hz, to convert the times to seconds
+		uint64_t ulPeriod;				//The PWM period according to timer clocks
+		uint64_t ulDeadTime;			//The applied deadtime according to timer clocks. It is 0 if the channel has no complementary output
+		Output_Edge_Type xOutput;		//The edges of CHx output
+		Output_Edge_Type xComplement;	//The edges of CHxN output. The falling edge is (ulRise + ulWidth) modulo ulPeriod
+	}Channel_Edges_Type;
+
+	typedef struct
+	{
+		GPIO_TypeDef* _pxPort;	//The GPIO port of software PWM channel. The pin should be configured as output
+		uint16_t _usPin;		//The GPIO pin of software PWM channel. It can be GPIO_PIN_0 to GPIO_PIN_15
+	}Software_Pin_Type;
+
+	typedef struct
+	{
+		uint32_t ulTick;							//The counter value of edges
+		uint32_t ulBSRR[SOFTWARE_PWM_PORTS];		//The Bit Set/Reset Register value of each port. 0 means the port has no edge
+	}Software_Slot_Type;
+
+	typedef struct
+	{
+		uint8_t ucSlots;									//The number of used slots
+		Software_Slot_Type xSlots[SOFTWARE_PWM_CHANNELS + 1];	//Slot 0 sets the pins at counter = 0 and the next slots are sorted by ulTick
+	}Software_Schedule_Type;
+
+	typedef enum
+	{
+		Probe_Start_PWM = 0,
+		Probe_Stop_PWM,
+		Probe_Start_All_PWM,
+		Probe_Stop_All_PWM,
+		Probe_Change_DutyCycle,
+		Probe_Change_Frequency,
+		Probe_Change_Frequency_Seamless,
+		Probe_Timer_Init,
+		Probe_Update_Event_Handler,
+		Probe_Count
+	}Probe_IdType;
+
+	typedef struct
+	{
+		uint32_t ulCalls;		//The number of calls
+		uint32_t ulMin;			//The minimum execution time according to cycles
+		uint32_t ulMax;			//The maximum execution time according to cycles
+		uint32_t ulHistogram[HARDWARE_PWM_HISTOGRAM_BINS];	//Log2 histogram of execution times
+	}Probe_Statistics_Type;
+
+	typedef struct
+	{
+		Probe_Statistics_Type xProbes[Probe_Count];
+		uint32_t ulSkipped_Writes;		//The number of register writes which are skipped because the value is not changed
+		uint32_t ulSaved_HAL_Calls;		//The number of HAL start/stop calls which are replaced by the enable register bit-mask operations
+	}PWM_Statistics_Type;
+
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+	/**
+	  * @brief  This class measures the execution time of a function from its creation to its destruction
+	  */
+	class Instrument_Probe
+	{
+	public:
+		inline Instrument_Probe(Probe_Statistics_Type* _pxStatistics)
+		{
+			this->pxStatistics = _pxStatistics;
+			this->ulStart = HARDWARE_PWM_CYCLE_COUNTER();
+		}
+
+		inline ~Instrument_Probe(void)
+		{
+			uint32_t Cycles = HARDWARE_PWM_CYCLE_COUNTER() - this->ulStart;
+			uint32_t Bin = 31 - (uint32_t)__builtin_clz(Cycles | 1);	//Log2 of cycles
+
+			if (Bin >= HARDWARE_PWM_HISTOGRAM_BINS)
+			{
+				Bin = HARDWARE_PWM_HISTOGRAM_BINS - 1;
+			}
+			if ((this->pxStatistics->ulCalls == 0) || (Cycles < this->pxStatistics->ulMin))
+			{
+				this->pxStatistics->ulMin = Cycles;
+			}
+			if (Cycles > this->pxStatistics->ulMax)
+			{
+				this->pxStatistics->ulMax = Cycles;
+			}
+			this->pxStatistics->ulHistogram[Bin]++;
+			this->pxStatistics->ulCalls++;
+		}
+
+	private:
+		Probe_Statistics_Type* pxStatistics;	//This pointer saves the address of statistics of the function
+		uint32_t ulStart;						//This variable saves the counter value at the start of function
+	};
+#endif
+
+	/* Lookup Tables -------------------------------------------------------------*/
+	/**
+	  * @brief  Table of Capture Compare Register values for one period of output signal.
+	  *			Declare the tables as constexpr variables in namespace scope, so they are placed in flash. For example:
+	  *			constexpr auto xSine_Table = Make_SPWM_Table<4199, 256>(0.95);
+	  */
+	template<typename T, uint32_t N>
+	struct PWM_Table_Type
+	{
+		T Ticks[N];
+	};
+
+	template<uint32_t Period>
+	using PWM_Tick_Type = typename std::conditional<(Period <= 0xFFFF), uint16_t, uint32_t>::type;	//The smallest type which saves the period value
+
+	namespace Table_Math
+	{
+		constexpr double Pi = 3.14159265358979323846;
+
+		/**
+		  * @brief  This function calculates sine at compile time
+		  * @param  _Angle: Angle according to radian
+		  * @retval Sine value
+		  */
+		constexpr double Sin(double _Angle)
+		{
+			double Term = 0;
+			double Sum = 0;
+
+			while (_Angle > Pi)		//Reduce the angle to -Pi..Pi
+			{
+				_Angle -= 2 * Pi;
+			}
+			while (_Angle < -Pi)
+			{
+				_Angle += 2 * Pi;
+			}
+
+			Term = _Angle;
+			Sum = _Angle;
+			for (uint32_t n = 1; n < 13; n++)	//Taylor series
+			{
+				Term *= -(_Angle * _Angle) / (double)((2 * n) * (2 * n + 1));
+				Sum += Term;
+			}
+			return Sum;
+		}
+
+		/**
+		  * @brief  This function converts a normalized value (-1..1) to a Capture Compare Register value
+		  * @param  _Period: Timer period value
+		  *			_Value: Normalized value
+		  * @retval Capture Compare Register value
+		  */
+		constexpr uint32_t To_Ticks(uint32_t _Period, double _Value)
+		{
+			double Ticks = (_Period / 2.0) * (1.0 + _Value) + 0.5;
+
+			if (Ticks < 0)
+			{
+				return 0;
+			}
+			if (Ticks > _Period)
+			{
+				return _Period;
+			}
+			return (uint32_t)Ticks;
+		}
+
+		constexpr uint32_t Log2(uint32_t _ulValue)
+		{
+			return (_ulValue <= 1) ? 0 : 1 + Log2(_ulValue >> 1);
+		}
+	}
+
+	/**
+	  * @brief  This function generates a sinusoidal PWM table at compile time
+	  * @param  Period: Timer period value (ulTimer_Period)
+	  *			Samples: Number of samples in one period of output signal. It should be a power of 2 and at least 2
+	  *			_Depth: Modulation depth. It can be 0 to 1
+	  * @retval The table
+	  */
+	template<uint32_t Period, uint32_t Samples>
+	constexpr PWM_Table_Type<PWM_Tick_Type<Period>, Samples> Make_SPWM_Table(double _Depth)
+	{
+		static_assert(Samples >= 2, "Samples should be 2 or more");
+		static_assert((Samples & (Samples - 1)) == 0, "Samples should be a power of 2");
+
+		PWM_Table_Type<PWM_Tick_Type<Period>, Samples> Table = {};
+
+		for (uint32_t i = 0; i < Samples; i++)
+		{
+			Table.Ticks[i] = (PWM_Tick_Type<Period>)Table_Math::To_Ticks(Period, _Depth * Table_Math::Sin((2 * Table_Math::Pi * i) / Samples));
+		}
+		return Table;
+	}
+
+	/**
+	  * @brief  This function generates a space vector PWM table at compile time (sine with min-max zero sequence injection).
+	  *			The table is for phase A. Phase B and C use the same table with 120 degrees offsets.
+	  * @param  Period: Timer period value (ulTimer_Period)
+	  *			Samples: Number of samples in one period of output signal. It should be a power of 2 and at least 2
+	  *			_Depth: Modulation depth. It can be 0 to 1.1547 (2/sqrt(3)) in linear region
+	  * @retval The table
+	  */
+	template<uint32_t Period, uint32_t Samples>
+	constexpr PWM_Table_Type<PWM_Tick_Type<Period>, Samples> Make_SVPWM_Table(double _Depth)
+	{
+		static_assert(Samples >= 2, "Samples should be 2 or more");
+		static_assert((Samples & (Samples - 1)) == 0, "Samples should be a power of 2");
+
+		PWM_Table_Type<PWM_Tick_Type<Period>, Samples> Table = {};
+		double Angle = 0;
+		double Va = 0, Vb = 0, Vc = 0;
+		double Max = 0, Min = 0;
+
+		for (uint32_t i = 0; i < Samples; i++)
+		{
+			Angle = (2 * Table_Math::Pi * i) / Samples;
+			Va = _Depth * Table_Math::Sin(Angle);
+			Vb = _Depth * Table_Math::Sin(Angle - (2 * Table_Math::Pi / 3));
+			Vc = _Depth * Table_Math::Sin(Angle + (2 * Table_Math::Pi / 3));
+			Max = (Va > Vb) ? ((Va > Vc) ? Va : Vc) : ((Vb > Vc) ? Vb : Vc);
+			Min = (Va < Vb) ? ((Va < Vc) ? Va : Vc) : ((Vb < Vc) ? Vb : Vc);
+			Table.Ticks[i] = (PWM_Tick_Type<Period>)Table_Math::To_Ticks(Period, Va - ((Max + Min) / 2));	//Add the zero sequence
+		}
+		return Table;
+	}
+
+	/**
+	  * @brief  This function calculates the phase step of a phase accumulator
+	  * @param  _OutputFrequency: Frequency of output signal according to Hz
+	  *			_StepFrequency: Frequency of steps according to Hz. Usually it is the PWM frequency
+	  * @retval Phase step
+	  */
+	constexpr uint32_t Phase_Step(double _OutputFrequency, double _StepFrequency)
+	{
+		return (uint32_t)((_OutputFrequency / _StepFrequency) * 4294967296.0);
+	}
+
 	
 	/* Class ---------------------------------------------------------------------*/
+	class Software_PWM;
+
 	class Hardware_PWM
 	{
 	public:
@@ -61,20 +458,626 @@ namespace Hardware_PWM_Ver1
 		void Start_All_PWM(double _DutyCycle);
 		void Stop_All_PWM(void);
 		void Change_DutyCycle(uint8_t _ucChannel, double _DutyCycle);
-		void Change_Frequency(uint32_t _ulNewFrequency);
+		bool Change_Frequency(uint32_t _ulNewFrequency);
+		bool Change_Frequency_Seamless(uint32_t _ulNewFrequency);
+		double Get_Actual_Frequency(void);
+		double Get_Solved_Frequency(uint32_t _ulFrequency);
+		uint32_t Get_Period(void);
+		void Invalidate_Timer_Clock(void);
+		void Set_Update_Rate(uint32_t _ulPeriods);
+		uint32_t Get_DeadTime(void);
+		bool Get_Channel_Edges(uint8_t _ucChannel, Channel_Edges_Type* _pxEdges);
+
+		/**
+		  * @brief  This function writes the table value of a phase to a running channel
+		  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+		  *			_xTable: Table which is generated by Make_SPWM_Table or Make_SVPWM_Table
+		  *			_ulPhase: Phase of output signal. 0x100000000 means 360 degrees
+		  * @retval None
+		  */
+		template<typename T, uint32_t N>
+		inline void Set_DutyCycle_Table(uint8_t _ucChannel, const PWM_Table_Type<T, N>& _xTable, uint32_t _ulPhase)
+		{
+			static_assert((N >= 2) && ((N & (N - 1)) == 0), "The table size should be a power of 2 and at least 2");
+
+			this->Channel_Store_Compare(_ucChannel >> 2, _xTable.Ticks[_ulPhase >> (32 - Table_Math::Log2(N))]);
+		}
+
+		/**
+		  * @brief  This function writes the table values of a 3 phase signal to channel 1,2,3 and steps the phase accumulator.
+		  *			Call it in each update event.
+		  * @param  _xTable: Table which is generated by Make_SPWM_Table or Make_SVPWM_Table
+		  *			_pxPhase: The address of phase accumulator
+		  * @retval None
+		  */
+		template<typename T, uint32_t N>
+		inline void Step_3Phase_Table(const PWM_Table_Type<T, N>& _xTable, Phase_Accumulator_Type* _pxPhase)
+		{
+			static_assert((N >= 2) && ((N & (N - 1)) == 0), "The table size should be a power of 2 and at least 2");
+
+			const uint32_t Shift = 32 - Table_Math::Log2(N);
+			uint32_t Phase = _pxPhase->ulPhase;
+
+			this->Channel_Store_Compare(0, _xTable.Ticks[Phase >> Shift]);
+			this->Channel_Store_Compare(1, _xTable.Ticks[(uint32_t)(Phase - 0x55555555U) >> Shift]);	//-120 degrees
+			this->Channel_Store_Compare(2, _xTable.Ticks[(uint32_t)(Phase + 0x55555555U) >> Shift]);	//+120 degrees
+			_pxPhase->ulPhase = Phase + _pxPhase->ulStep;
+		}
+
+		void Set_All_DutyCycle(const double _DutyCycles[4]);
+		void Set_All_DutyCycle_Ticks(const uint32_t _ulTicks[4]);
+		void Begin_Update(void);
+		void End_Update(void);
+
+		bool Start_Streaming(uint32_t* _pulBuffer, uint16_t _usFrameCount, Stream_Callback_Type _pxCallback, void* _pvContext);
+		void Stop_Streaming(void);
+		uint32_t* Stream_Get_Free_Half(void);
+		bool Stream_Commit_Half(uint32_t* _pulHalf);
+		uint32_t Get_Stream_Underruns(void);
+		void Spread_Spectrum_Build(uint32_t* _pulFrames, uint16_t _usFrameCount, Spread_ProfileType _xProfile, double _SpreadPercent);
+		void Start_Spread_Spectrum(uint32_t* _pulFrames, uint16_t _usFrameCount);
+		void Stop_Spread_Spectrum(void);
+		uint16_t Ramp_Build_DutyCycle(uint32_t* _pulFrames, uint16_t _usFrameCount, uint8_t _ucChannel, double _DutyCycle, uint32_t _ulTime, Ramp_ShapeType _xShape);
+		uint16_t Ramp_Build_Frequency(uint32_t* _pulFrames, uint16_t _usFrameCount, uint32_t _ulNewFrequency, uint32_t _ulTime, Ramp_ShapeType _xShape);
+		bool Start_Ramp(uint32_t* _pulFrames, uint16_t _usFrameCount);
+		void Stop_Ramp(void);
+		bool Ramp_Is_Running(void);
+
+#if defined(TIM_OCMODE_COMBINED_PWM1)
+		bool Set_Phase_Ticks(uint8_t _ucChannel, uint32_t _ulPhase, uint32_t _ulDutyTicks);
+		bool Set_Phase_Degrees(uint8_t _ucChannel, double _Phase, double _DutyCycle);
+#endif
+		void Update_Event_Handler(void);
+
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+		const PWM_Statistics_Type* Get_Statistics(void);
+		void Reset_Statistics(void);
+#endif
+
+		void Start_Command_Queue(void);
+		void Stop_Command_Queue(void);
+		void Post_DutyCycle(uint8_t _ucChannel, double _DutyCycle);
+		void Post_DutyCycle_Q16(uint8_t _ucChannel, uint32_t _ulDutyCycle);
+		bool Post_Frequency(uint32_t _ulNewFrequency);
+
+		void Set_DutyCycle_HighRes_Q8(uint8_t _ucChannel, uint32_t _ulTicks_Q8);
+		void Set_DutyCycle_HighRes(uint8_t _ucChannel, double _DutyCycle);
+		void Start_Dithering(uint8_t _ucOrder, bool _xUseInterrupt);
+		void Stop_Dithering(void);
+		static void Dither_Stream_Callback(uint32_t* _pulFrames, uint16_t _usFrameCount, void* _pvContext);
+
+		bool Start_Pulse_Train(uint8_t _ucChannel, uint32_t _ulPulses, double _DutyCycle);
+		bool Start_Pulse_Profile(uint8_t _ucChannel, const Pulse_Segment_Type* _pxSegments, uint16_t _usSegmentCount, double _DutyCycle);
+		void Stop_Pulse_Train(void);
+		bool Pulse_Train_Is_Running(void);
+		void Pulse_Ramp_Build(Pulse_Segment_Type* _pxSegments, uint16_t _usSegmentCount, uint32_t _ulStartFrequency, uint32_t _ulEndFrequency, uint32_t _ulPulses);
+
+		bool Start_ADC_Trigger(const ADC_Trigger_Type* _pxTrigger);
+		void Stop_ADC_Trigger(void);
+		void Update_ADC_Trigger(void);
+
+		void Set_Break_Config(const Break_Config_Type* _pxConfig);
+		void Break_Event_Handler(void);
+		bool Get_Break_Status(void);
+		uint32_t Get_Break_Count(void);
+		bool Break_Recover(void);
+
+		/* Fast path functions. They only write the Capture Compare Register, so the channel should be started by Start_PWM before */
+		/**
+		  * @brief  This function sets the dutycycle of a running channel according to timer ticks
+		  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+		  *			_ulTicks: Dutycycle value according to timer ticks. It can be 0 to period value
+		  * @retval None
+		  */
+		inline void Set_DutyCycle_Ticks(uint8_t _ucChannel, uint32_t _ulTicks)
+		{
+			this->Channel_Store_Compare(_ucChannel >> 2, _ulTicks);	//TIM_CHANNEL_x values are 0, 4, 8, 12
+		}
+
+		/**
+		  * @brief  This function sets the dutycycle of a running channel according to Q15 fraction
+		  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+		  *			_usDutyCycle: Dutycycle value in Q15 format. 0x8000 means 100%
+		  * @retval None
+		  */
+		inline void Set_DutyCycle_Q15(uint8_t _ucChannel, uint16_t _usDutyCycle)
+		{
+			this->Channel_Store_Compare(_ucChannel >> 2, (uint32_t)(((uint64_t)this->ulTimer_Period * _usDutyCycle) >> 15));
+		}
+
+		/**
+		  * @brief  This function sets the dutycycle of a running channel according to Q16 fraction
+		  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+		  *			_ulDutyCycle: Dutycycle value in Q16 format. 0x10000 means 100%
+		  * @retval None
+		  */
+		inline void Set_DutyCycle_Q16(uint8_t _ucChannel, uint32_t _ulDutyCycle)
+		{
+			this->Channel_Store_Compare(_ucChannel >> 2, (uint32_t)(((uint64_t)this->ulTimer_Period * _ulDutyCycle) >> 16));
+		}
 
 
 	private:
+		friend class Hardware_PWM_Group;
+		friend class Software_PWM;
+
 		TIM_HandleTypeDef* pxTimer;			//This pointer saves the address of timer handle variable
 		PWM_Channels* pxUsed_Channels;		//This pointer saves the address of channels status variable
 		TimerSpecs_Type* pxTimerSpecs_Data;	//This pointer saves the address of timer specification values vaiable
 		uint64_t ulTimer_Prescaler;			//This variable saves the prescaler value
 		uint32_t ulTimer_Period;			//This variable saves the period value
+		double dTimer_Frequency;			//This variable saves the PWM frequency which is generated by the timer
+		uint32_t ulTimer_Clock;				//This variable saves the timer clock frequency. 0 means it should be resolved again
+		uint32_t ulTimer_ClockDivision;		//This variable saves the clock division of deadtime generator
+		uint32_t ulTimer_DeadTime;			//This variable saves the applied deadtime value according to nS
+		uint32_t ulTimer_DeadTime_Clocks;	//This variable saves the applied deadtime value according to timer clocks
+		uint32_t ulTimer_DeadTime_Clock;	//This variable saves the timer clock which the deadtime is calculated for
+		uint32_t ulTimer_TriggerOutput;		//This variable saves the master trigger output (TRGO) source
+#if defined(TIM_TRGO2_OC4REF)
+		uint32_t ulTimer_TriggerOutput2;	//This variable saves the second master trigger output (TRGO2) source
+#endif
+		uint32_t ulTimer_MasterSlaveMode;	//This variable saves the master/slave mode of master configuration
+		bool xTimer_IsSlave;				//This variable specifies the timer is started by another timer
+		uint32_t ulTimer_InputTrigger;		//This variable saves the internal trigger of a slave timer
+		volatile uint32_t ulPhase_Stretch;	//This variable saves the timer ticks which the counter should be delayed to shift the phase
+		uint32_t ulPhase_Compare[4];		//This array saves the Capture Compare Register values of phase shifted channel pairs
+		volatile uint8_t ucPhase_Pending;	//Bit 0 and bit 1 show the phase of channel pair 1,2 and 3,4 should be applied
+		uint8_t ucPhase_Wrap;				//Bit 0 and bit 1 show the pulse of channel pair 1,2 and 3,4 passes the update event
+		volatile uint8_t ucDither_Channels;	//Bit 0 to bit 3 show channel 1,2,3,4 are in high resolution mode
+		uint8_t ucDither_Order;				//This variable saves the order of sigma-delta modulator
+		bool xDither_Interrupt;				//This variable shows the dithering is done in the update interrupt
+		volatile uint32_t ulDither_Target[4];	//This array saves the high resolution dutycycles according to timer ticks * 256
+		int32_t lDither_Error[4][2];		//This array saves the last two quantization errors of each channel
+		bool xCommand_Enabled;				//This variable shows the posted commands are applied in the update event
+		uint32_t ulCommand_DutyCycle[4];	//This array saves the last posted dutycycle of each channel in Q16 format
+		Command_Record_Type xCommand_Record[2];	//The Post functions fill one record and the update interrupt reads the other one
+		volatile uint8_t ucCommand_Record;	//This variable saves the index of the last posted record
+		volatile uint8_t ucCommand_Pending[4];		//This array shows a dutycycle is posted for each channel
+		volatile uint8_t ucCommand_Pending_Frequency;	//This variable shows a frequency is posted
+		volatile bool xPulse_Running;		//This variable shows a pulse train is generated
+		bool xPulse_Interrupt;				//This variable shows the update interrupt was enabled before the pulse train
+		bool xUpdate_Interrupt;				//This variable shows the update interrupt is enabled by this class, so it is disabled when no function uses it
+		uint8_t ucPulse_Channel;			//This variable saves the channel index of pulse train
+		uint32_t ulPulse_DutyCycle;			//This variable saves the dutycycle of pulses in Q16 format
+		const Pulse_Segment_Type* pxPulse_Segments;	//This pointer saves the address of segment table
+		uint16_t usPulse_Segment_Count;		//This variable saves the number of segments
+		uint16_t usPulse_Segment;			//This variable saves the index of next segment which is not started
+		uint32_t ulPulse_Period;			//This variable saves the Auto Reload Register value of current segment
+		uint32_t ulPulse_Left;				//This variable saves the pulses of current segment which are not loaded to the timer
+		Pulse_Segment_Type xPulse_Single;	//This variable saves the only segment of Start_Pulse_Train
+		bool xTrigger_Enabled;				//This variable shows the ADC trigger is started
+		ADC_Trigger_Type xTrigger;			//This variable saves the ADC trigger configuration
+		Break_Config_Type xBreak_Config;	//This variable saves the break and idle state configuration
+		volatile bool xBreak_Fault;			//This variable shows a break is happened and it is not recovered
+		volatile uint32_t ulBreak_Count;	//This variable counts the break events
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+		PWM_Statistics_Type xStatistics;	//This variable saves the execution time statistics of functions
+#endif
+		Register_Type* pulChannel_CCR[4];	//This array saves the address of Capture Compare Register of each channel
+		uint32_t ulCompare_Shadow[4];		//This array saves the last Capture Compare Register values which are written by the CPU
+		uint32_t ulPeriod_Shadow;			//This variable saves the last Auto Reload Register value which is written by the CPU
+		uint32_t ulPrescaler_Shadow;		//This variable saves the last prescaler register value which is written by the CPU
+		uint64_t ulDuty_Ticks[4];			//This array saves the dutycycle ratio of each channel (ulDuty_Ticks / ulDuty_Counts) for frequency changes
+		uint64_t ulDuty_Counts[4];
+		uint32_t ulDuty_Scaled[4];			//This array saves the Capture Compare Register values which are calculated from the ratios
+		uint8_t ucChannel_Running;			//Bit 0 to bit 3 show channel 1,2,3,4 are started
+		volatile uint8_t ucUpdate_Depth;	//This variable saves the nesting depth of Begin_Update calls. The update event is held if it is not 0
+		DMA_ModeType xDMA_Mode;				//This variable saves the current usage of the update DMA request
+		uint32_t* pulStream_Buffer;			//This pointer saves the address of the streaming ring buffer
+		uint16_t usStream_Frames;			//This variable saves the number of frames in the streaming ring buffer
+		volatile uint8_t ucStream_Ready;	//Bit 0 and bit 1 show the first and the second half of the ring buffer are filled
+		volatile uint32_t ulStream_Underruns;	//This variable counts the halves which are played before they are filled
+		Stream_Callback_Type pxStream_Callback;	//This pointer saves the refill function of the streaming ring buffer
+		void* pvStream_Context;				//This pointer is passed to the refill function
+		uint32_t ulSpread_Compare[4];		//This array saves the nominal Capture Compare Register values in spread spectrum mode
+		uint32_t* pulRamp_Frames;			//This pointer saves the address of the ramp table
+		uint16_t usRamp_Frames;				//This variable saves the number of frames in the ramp table
+		Software_PWM* pxSoftware;			//This pointer saves the software PWM channels which use a compare channel of the timer
 
 		void Timer_Init(void);
+		void Channel_Registers_Init(void);
+		void Register_Shadow_Sync(void);
+		Channel_ModeType Get_Channel_Mode(uint8_t _ucIndex);
+		uint32_t Channel_Enable_Mask(uint8_t _ucChannels);
+		void Channel_Write_Compare(uint8_t _ucIndex, uint32_t _ulTicks);
+		void Channel_Outputs_Enable(uint8_t _ucChannels);
+		void Channel_Outputs_Disable(uint8_t _ucChannels);
+		void Channel_HAL_State(uint8_t _ucChannels, bool _xBusy);
+		bool Frequency_Write(uint32_t _ulNewFrequency);
+		void Frequency_Apply(uint32_t _ulNewFrequency, uint64_t _ulPrescaler, uint32_t _ulPeriod);
+		void Timer_Config_Master(void);
+		void Timer_Config_Slave(uint32_t _ulInputTrigger);
+		void Stream_Half_Done(uint8_t _ucHalf);
+		uint16_t Ramp_Build(uint32_t* _pulFrames, uint16_t _usFrameCount, uint8_t _ucIndex, double _Target, uint32_t _ulTime, Ramp_ShapeType _xShape);
+		void Ramp_Finish(uint32_t _ulPeriod);
+		bool DMA_Burst_Start(DMA_ModeType _xMode, uint32_t _ulBaseAddress, uint32_t _ulBurstLength, uint32_t* _pulBuffer, uint32_t _ulWords);
+		void DMA_Burst_Stop(void);
+		void DMA_HalfTransfer_Handler(void);
+		void DMA_TransferComplete_Handler(void);
+		static Hardware_PWM* DMA_Find(DMA_HandleTypeDef* _pxDMA);
+		static void DMA_Half_Callback(DMA_HandleTypeDef* _pxDMA);
+		static void DMA_Complete_Callback(DMA_HandleTypeDef* _pxDMA);
 		void Timer_Calculator(uint32_t _ulFrequency);
+		void Timer_Solve(uint32_t _ulFrequency, uint64_t* _pulPrescaler, uint32_t* _pulPeriod);
+		void Timer_Update_Frequency(void);
+		bool Timer_Frequency_Is_Valid(uint32_t _ulFrequency);
+		uint64_t Timer_Period_Capacity(void);
 		uint32_t Timer_Get_Frequency(void);
+		uint32_t Timer_Resolve_Frequency(void);
+		bool Timer_Is_Center_Aligned(void);
+		uint64_t Timer_Counts(void);
+		uint32_t Timer_Repetition_Max(void);
+		uint32_t Dither_Next(uint8_t _ucIndex);
+		bool Update_Interrupt_Is_Used(void);
+		void Update_Interrupt_Enable(void);
+		void Update_Interrupt_Release(void);
+		bool Software_Is_Running(void);
+		void Software_Resync(void);
+		void Command_Apply(void);
+		Command_Record_Type* Command_Next_Record(void);
+		void Command_Publish(Command_Record_Type* _pxRecord, uint8_t _ucChannels);
+		bool Pulse_Load_Next(void);
+		void Pulse_Train_Finish(void);
+		void Channel_Set_OC_Mode(uint8_t _ucIndex, uint32_t _ulMode);
+		void Timer_Config_Trigger_Output(void);
+		void Timer_Write_Base(void);
+		uint32_t ADC_Trigger_Point(uint64_t _ulCounts, uint64_t _ulCompare);
+		void Timer_Config_Break(uint8_t _ucDeadTime);
 		uint8_t Timer_DeadTime_Calculator(void);
+
+		/**
+		  * @brief  This function writes the Capture Compare Register of a channel and its software copy
+		  * @param  _ucIndex: The channel index. It can be 0,1,2,3 for channel 1,2,3,4
+		  *			_ulTicks: Capture Compare Register value
+		  * @retval None
+		  */
+		inline void Channel_Store_Compare(uint8_t _ucIndex, uint32_t _ulTicks)
+		{
+			this->ulCompare_Shadow[_ucIndex] = _ulTicks;
+			*this->pulChannel_CCR[_ucIndex] = _ulTicks;
+		}
+
+		/**
+		  * @brief  This function returns the Capture Compare Register value of a channel. The software copy is used unless
+		  *			the register is written by the update DMA request
+		  * @param  _ucIndex: The channel index. It can be 0,1,2,3 for channel 1,2,3,4
+		  * @retval Capture Compare Register value
+		  */
+		inline uint32_t Channel_Read_Compare(uint8_t _ucIndex)
+		{
+			return (this->xDMA_Mode == IdleMode) ? this->ulCompare_Shadow[_ucIndex] : (uint32_t)*this->pulChannel_CCR[_ucIndex];
+		}
+
+		/**
+		  * @brief  This function writes the Auto Reload Register and its software copy
+		  * @param  _ulPeriod: Auto Reload Register value
+		  * @retval None
+		  */
+		inline void Timer_Store_Period(uint32_t _ulPeriod)
+		{
+			this->ulPeriod_Shadow = _ulPeriod;
+			this->pxTimer->Instance->ARR = _ulPeriod;
+		}
+
+		/**
+		  * @brief  This function writes the prescaler register and its software copy
+		  * @param  _ulPrescaler: Prescaler register value
+		  * @retval None
+		  */
+		inline void Timer_Store_Prescaler(uint32_t _ulPrescaler)
+		{
+			this->ulPrescaler_Shadow = _ulPrescaler;
+			this->pxTimer->Instance->PSC = _ulPrescaler;
+		}
+	};
+
+	/**
+	  * @brief  Group of synchronized timers. The master timer starts all slave timers by its trigger output (TRGO),
+	  *			so more than four phase locked channels can be controlled together.
+	  */
+	class Hardware_PWM_Group
+	{
+	public:
+		Hardware_PWM_Group(Hardware_PWM* _pxMaster);
+		~Hardware_PWM_Group(void);
+
+		bool Add_Slave(Hardware_PWM* _pxSlave, uint32_t _ulInputTrigger);
+		void Start_All_PWM(double _DutyCycle);
+		void Stop_All_PWM(void);
+		void Set_All_DutyCycle_Ticks(const uint32_t _ulTicks[][4]);
+		bool Change_Frequency(uint32_t _ulNewFrequency);
+		void Set_Phase_Ticks(uint8_t _ucTimer, uint32_t _ulPhase);
+		void Set_Phase_Degrees(uint8_t _ucTimer, double _Phase);
+
+	private:
+		Hardware_PWM* pxTimers[HARDWARE_PWM_GROUP_SIZE];	//This array saves the timers of group. The first one is the master
+		uint8_t ucTimer_Count;								//This variable saves the number of timers in the group
+		uint32_t ulTimer_Phase[HARDWARE_PWM_GROUP_SIZE];	//This array saves the phase of each timer according to the master timer ticks
+		bool xGroup_Running;								//This variable shows the group is started
+
+		bool Slave_Prescaler(Hardware_PWM* _pxSlave, uint64_t _ulPrescaler, uint32_t _ulPeriod, uint64_t* _pulSlave_Prescaler);
+	};
+
+	/**
+	  * @brief  Software PWM channels on GPIO pins. One compare channel of a running timer interrupts at each edge time,
+	  *			so the software channels have the frequency of the timer (edge aligned mode). The edges are kept in a
+	  *			sorted schedule and the pins of each port which change together are written by one BSRR store.
+	  *			The functions are like Hardware_PWM functions, but the channel is the index of pin in the pin table.
+	  *			The compare channel should be Disable in PWM_Channels and its interrupt should call Compare_Event_Handler.
+	  *			If the timer is controlled by a Hardware_PWM object, use the constructor with Hardware_PWM, so the counter
+	  *			is not stopped, the compare channel is not cleared and the edges are scaled by Change_Frequency and
+	  *			Change_Frequency_Seamless. The frequency of command mailbox and the ramps do not scale the edges.
+	  */
+	class Software_PWM
+	{
+	public:
+		Software_PWM(TIM_HandleTypeDef* _pxTimer, uint8_t _ucCompare_Channel, const Software_Pin_Type* _pxPins, uint8_t _ucPin_Count);
+		Software_PWM(Hardware_PWM* _pxPWM, uint8_t _ucCompare_Channel, const Software_Pin_Type* _pxPins, uint8_t _ucPin_Count);
+		~Software_PWM(void);
+
+		void Start_PWM(uint8_t _ucChannel, double _DutyCycle);
+		void Stop_PWM(uint8_t _ucChannel);
+		void Start_All_PWM(double _DutyCycle);
+		void Stop_All_PWM(void);
+		void Change_DutyCycle(uint8_t _ucChannel, double _DutyCycle);
+		void Update_Period(void);
+		uint8_t Get_Channel_Count(void);
+		void Compare_Event_Handler(void);
+
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+		const Probe_Statistics_Type* Get_Statistics(void);
+		void Reset_Statistics(void);
+#endif
+
+	private:
+		friend class Hardware_PWM;
+
+		TIM_HandleTypeDef* pxTimer;				//This pointer saves the address of timer handle variable
+		Hardware_PWM* pxPWM;					//This pointer saves the Hardware_PWM object of timer. It is NULL if it is not attached
+		uint8_t ucCompare_Index;				//This variable saves the index (0,1,2,3) of the compare channel
+		Register_Type* pulCompare;			//This pointer saves the address of Capture Compare Register of the compare channel
+		uint32_t ulCompare_Flag;				//This variable saves the interrupt flag of the compare channel
+		uint32_t ulTimer_Counts;				//This variable saves the number of timer ticks in a period (ARR + 1)
+		GPIO_TypeDef* pxPorts[SOFTWARE_PWM_PORTS];	//This array saves the GPIO ports of channels
+		uint8_t ucPort_Count;					//This variable saves the number of used ports
+		uint8_t ucChannel_Count;				//This variable saves the number of channels
+		uint8_t ucChannel_Port[SOFTWARE_PWM_CHANNELS];		//This array saves the port index of each channel
+		uint16_t usChannel_Pin[SOFTWARE_PWM_CHANNELS];		//This array saves the pin of each channel
+		uint32_t ulChannel_DutyCycle[SOFTWARE_PWM_CHANNELS];	//This array saves the dutycycle of each channel in Q16 format
+		uint32_t ulChannel_Ticks[SOFTWARE_PWM_CHANNELS];	//This array saves the dutycycle of each channel according to timer ticks
+		uint32_t ulChannel_Running;				//Bit n shows channel n is started
+		Software_Schedule_Type xSchedule[2];	//The interrupt plays one schedule and the functions edit the other one
+		volatile uint8_t ucSchedule_Active;		//This variable saves the index of schedule which is played by the interrupt
+		uint8_t ucSchedule_Latest;				//This variable saves the index of schedule which is edited last
+		volatile bool xSchedule_Pending;		//This variable shows the edited schedule should be played from the next period
+		uint8_t ucSlot;							//This variable saves the index of slot which is written in the next interrupt
+#if (HARDWARE_PWM_INSTRUMENTATION == 1)
+		Probe_Statistics_Type xStatistics;		//This variable saves the execution time statistics of Compare_Event_Handler
+#endif
+
+		Software_Schedule_Type* Schedule_Begin(void);
+		void Schedule_Commit(void);
+		uint8_t Schedule_Find(const Software_Schedule_Type* _pxSchedule, uint32_t _ulTick);
+		void Schedule_Remove(Software_Schedule_Type* _pxSchedule, uint8_t _ucChannel);
+		void Schedule_Insert(Software_Schedule_Type* _pxSchedule, uint8_t _ucChannel);
+		void Channel_Update(Software_Schedule_Type* _pxSchedule, uint8_t _ucChannel, uint32_t _ulDutyCycle, bool _xRunning);
+		void Compare_Config(void);
+		void Timer_Start(void);
+		void Timer_Resync(void);
+	};
+}
+
+/**
+  * @brief  Hardware PWM controller Class with compile time configuration. Version 1
+  *			The timer, channel modes and timer width are template parameters, so unused channels are removed by the
+  *			compiler and register addresses are constants. All functions access the timer registers directly.
+  *			The timer is given by a class with a static Instance function, Timer_Address for a peripheral address.
+  *			The timer should be initialized before, for example by Hardware_PWM class or CubeMX, and then only this
+  *			class should start and stop its channels. For example:
+  *			Hardware_PWM_Static<Timer_Address<TIM1_BASE>, ComplementMode, ComplementMode, ComplementMode, Disable, false> xInverter(xPWM.Get_Period());
+  */
+namespace Hardware_PWM_Ver1
+{
+	/**
+	  * @brief  The timer of Hardware_PWM_Static at a constant peripheral address, for example Timer_Address<TIM1_BASE>
+	  */
+	template<uintptr_t TimerBase>
+	struct Timer_Address
+	{
+		static inline TIM_TypeDef* Instance(void)
+		{
+			return reinterpret_cast<TIM_TypeDef*>(TimerBase);
+		}
+	};
+
+	template<typename TimerAccess, Channel_ModeType Mode1, Channel_ModeType Mode2, Channel_ModeType Mode3, Channel_ModeType Mode4, bool TimerIs32bit>
+	class Hardware_PWM_Static
+	{
+	public:
+		typedef typename std::conditional<TimerIs32bit, uint32_t, uint16_t>::type Tick_Type;	//The type of timer registers
+
+		Hardware_PWM_Static(uint32_t _ulTimer_Period)
+		{
+			this->ulTimer_Period = (Tick_Type)_ulTimer_Period;
+		}
+
+		/**
+		  * @brief  This function starts a PWM channel
+		  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+		  *			_DutyCycle: Dutycycle value according to percent.
+		  * @retval None
+		  */
+		inline void Start_PWM(uint8_t _ucChannel, double _DutyCycle)
+		{
+			Tick_Type Ticks = (Tick_Type)(this->ulTimer_Period * (_DutyCycle / 100.0));
+
+			switch (_ucChannel)
+			{
+			case TIM_CHANNEL_1:
+				this->Start_Channel<TIM_CHANNEL_1>(Ticks);
+				break;
+			case TIM_CHANNEL_2:
+				this->Start_Channel<TIM_CHANNEL_2>(Ticks);
+				break;
+			case TIM_CHANNEL_3:
+				this->Start_Channel<TIM_CHANNEL_3>(Ticks);
+				break;
+			case TIM_CHANNEL_4:
+				this->Start_Channel<TIM_CHANNEL_4>(Ticks);
+				break;
+			}
+		}
+
+		/**
+		  * @brief  This function stops a PWM channel
+		  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+		  * @retval None
+		  */
+		inline void Stop_PWM(uint8_t _ucChannel)
+		{
+			switch (_ucChannel)
+			{
+			case TIM_CHANNEL_1:
+				this->Outputs_Disable(Mask<TIM_CHANNEL_1>());
+				break;
+			case TIM_CHANNEL_2:
+				this->Outputs_Disable(Mask<TIM_CHANNEL_2>());
+				break;
+			case TIM_CHANNEL_3:
+				this->Outputs_Disable(Mask<TIM_CHANNEL_3>());
+				break;
+			case TIM_CHANNEL_4:
+				this->Outputs_Disable(Mask<TIM_CHANNEL_4>());
+				break;
+			}
+		}
+
+		/**
+		  * @brief  This function starts all PWM channels with a dutycycle value. All channels are enabled by one register write
+		  * @param  _DutyCycle: Dutycycle value according to percent.
+		  * @retval None
+		  */
+		inline void Start_All_PWM(double _DutyCycle)
+		{
+			Tick_Type Ticks = (Tick_Type)(this->ulTimer_Period * (_DutyCycle / 100.0));
+
+			this->Set_DutyCycle_Ticks<TIM_CHANNEL_1>(Ticks);
+			this->Set_DutyCycle_Ticks<TIM_CHANNEL_2>(Ticks);
+			this->Set_DutyCycle_Ticks<TIM_CHANNEL_3>(Ticks);
+			this->Set_DutyCycle_Ticks<TIM_CHANNEL_4>(Ticks);
+			this->Outputs_Enable(All_Mask());
+		}
+
+		/**
+		  * @brief  This function stops all PWM channels by one register write
+		  * @param  None
+		  * @retval None
+		  */
+		inline void Stop_All_PWM(void)
+		{
+			this->Outputs_Disable(All_Mask());
+		}
+
+		/**
+		  * @brief  This function changes the dutycycle of a channel
+		  * @param  _ucChannel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+		  *			_DutyCycle: Dutycycle value according to percent.
+		  * @retval None
+		  */
+		inline void Change_DutyCycle(uint8_t _ucChannel, double _DutyCycle)
+		{
+			this->Start_PWM(_ucChannel, _DutyCycle);
+		}
+
+		/**
+		  * @brief  This function sets the dutycycle of a channel according to timer ticks. The channel is known at compile time,
+		  *			so it is only one store to a constant address. It does nothing for a disabled channel.
+		  * @param  Channel: The channel number of timer. It can be TIM_CHANNEL_1,2,3,4
+		  *			_xTicks: Dutycycle value according to timer ticks
+		  * @retval None
+		  */
+		template<uint8_t Channel>
+		inline void Set_DutyCycle_Ticks(Tick_Type _xTicks)
+		{
+			if (Mode<Channel>() != Disable)
+			{
+				*(&Timer()->CCR1 + (Channel >> 2)) = _xTicks;
+			}
+		}
+
+	private:
+		Tick_Type ulTimer_Period;	//This variable saves the period value
+
+		static inline TIM_TypeDef* Timer(void)
+		{
+			return TimerAccess::Instance();
+		}
+
+		template<uint8_t Channel>
+		static constexpr Channel_ModeType Mode(void)
+		{
+			return (Channel == TIM_CHANNEL_1) ? Mode1 : (Channel == TIM_CHANNEL_2) ? Mode2 : (Channel == TIM_CHANNEL_3) ? Mode3 : Mode4;
+		}
+
+		template<uint8_t Channel>
+		static constexpr uint32_t Mask(void)	//Enable bits of a channel in the Capture Compare Enable Register
+		{
+			return (Mode<Channel>() == SingleMode) ? (TIM_CCER_CC1E << Channel) :
+				   (Mode<Channel>() == ComplementMode) ? ((TIM_CCER_CC1E | TIM_CCER_CC1NE) << Channel) : 0;
+		}
+
+		static constexpr uint32_t All_Mask(void)
+		{
+			return Mask<TIM_CHANNEL_1>() | Mask<TIM_CHANNEL_2>() | Mask<TIM_CHANNEL_3>() | Mask<TIM_CHANNEL_4>();
+		}
+
+		static constexpr uint32_t Break_Flags(void)	//Break flags in the status register
+		{
+#if defined(TIM_SR_B2IF)
+			return TIM_SR_BIF | TIM_SR_B2IF;
+#else
+			return TIM_SR_BIF;
+#endif
+		}
+
+		template<uint8_t Channel>
+		inline void Start_Channel(Tick_Type _xTicks)
+		{
+			if (Mode<Channel>() != Disable)
+			{
+				this->Set_DutyCycle_Ticks<Channel>(_xTicks);
+				this->Outputs_Enable(Mask<Channel>());
+			}
+		}
+
+		static inline void Outputs_Enable(uint32_t _ulMask)
+		{
+			if (_ulMask != 0)
+			{
+				Timer()->CCER |= _ulMask;	//Enable the outputs
+				if (IS_TIM_BREAK_INSTANCE(Timer()) && ((Timer()->SR & Break_Flags()) == 0))	//A latched break keeps the main output disabled
+				{
+					Timer()->BDTR |= TIM_BDTR_MOE;	//Main output enable
+				}
+				Timer()->CR1 |= TIM_CR1_CEN;	//Enable the counter
+			}
+		}
+
+		static inline void Outputs_Disable(uint32_t _ulMask)
+		{
+			if (_ulMask != 0)
+			{
+				Timer()->CCER &= ~_ulMask;	//Disable the outputs
+				if ((Timer()->CCER & All_Mask()) == 0)	//All channels are stopped
+				{
+					if (IS_TIM_BREAK_INSTANCE(Timer()))
+					{
+						Timer()->BDTR &= ~TIM_BDTR_MOE;
+					}
+					Timer()->CR1 &= ~TIM_CR1_CEN;
+				}
+			}
+		}
 	};
 }
 
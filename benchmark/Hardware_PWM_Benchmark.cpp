@@ -0,0 +1,369 @@
+/**
+  ******************************************************************************
+  * @file    Hardware_PWM_Benchmark.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Host benchmark of Hardware_PWM public functions. For each function
+  *          it prints the time (nS per call) and the register reads, register
+  *          writes and HAL calls per call which are counted by the host model.
+  *          The times include the counting overhead of the model, so compare
+  *          them only with each other. The access counts are exact.
+  *          The code of Hardware_PWM_Static functions is in the Size_Static_
+  *          functions. Their size and the size of the same Hardware_PWM
+  *          functions are listed by: nm --print-size -C Hardware_PWM_Benchmark_LL
+  *          | grep -E "Size_Static_|Hardware_PWM::(Change_DutyCycle|Start_All_PWM|Set_DutyCycle_Ticks)\("
+  *          Usage: Hardware_PWM_Benchmark_LL [iterations]
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Hardware_PWM.hpp"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Hardware_PWM_Ver1;
+
+/* Variables -----------------------------------------------------------------*/
+static TIM_HandleTypeDef xTimer;
+static DMA_HandleTypeDef xTimer_DMA;
+static PWM_Channels xChannels = {ComplementMode, ComplementMode, ComplementMode, SingleMode};
+static TimerSpecs_Type xSpecs = {20000, false, 100, TIM_COUNTERMODE_UP, 0};
+static uint32_t ulFrames[64 * 6];
+static uint32_t ulStream[16 * 4];
+static Pulse_Segment_Type xSegments[8];
+constexpr auto xSine_Table = Make_SPWM_Table<8499, 256>(0.9);
+
+typedef Hardware_PWM_Static<Host_Timer<Host_TIM1>, ComplementMode, ComplementMode, ComplementMode, Disable, false> Static_PWM_Type;
+
+/* Functions -----------------------------------------------------------------*/
+/**
+  * @brief  These functions are not inlined, so the code size of Hardware_PWM_Static can be compared with the same
+  *			functions of Hardware_PWM
+  */
+__attribute__((noinline)) void Size_Static_Change_DutyCycle(Static_PWM_Type* _pxPWM, uint8_t _ucChannel, double _DutyCycle)
+{
+	_pxPWM->Change_DutyCycle(_ucChannel, _DutyCycle);
+}
+
+__attribute__((noinline)) void Size_Static_Start_All_PWM(Static_PWM_Type* _pxPWM, double _DutyCycle)
+{
+	_pxPWM->Start_All_PWM(_DutyCycle);
+}
+
+__attribute__((noinline)) void Size_Static_Set_DutyCycle_Ticks(Static_PWM_Type* _pxPWM, uint32_t _ulTicks)
+{
+	_pxPWM->Set_DutyCycle_Ticks<TIM_CHANNEL_1>((uint16_t)_ulTicks);
+}
+
+/**
+  * @brief  This function runs a function and prints its cost per call
+  * @param  _pcName: Name of the function
+  *			_ulIterations: The number of calls
+  *			_xFunction: The function. Its parameter is the iteration number
+  * @retval None
+  */
+template<typename F>
+static void Measure(const char* _pcName, uint32_t _ulIterations, F _xFunction)
+{
+	std::chrono::steady_clock::time_point Start;
+	double Time = 0;
+
+	Host_Reset_Counters();
+	Start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < _ulIterations; i++)
+	{
+		_xFunction(i);
+	}
+	Time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count();
+
+	printf("%-44s %10.1f %10.2f %10.2f %10.2f\n", _pcName, Time / _ulIterations, (double)xHost_Counters.ulReads / _ulIterations,
+		   (double)xHost_Counters.ulWrites / _ulIterations, (double)xHost_Counters.ulHAL_Calls / _ulIterations);
+}
+
+/**
+  * @brief  This function is the prescaler search of version 1.0.0 (Timer_Calculator) which is kept for comparison with
+  *			Timer_Solve. It increases the prescaler until the period fits in the timer and truncates the period.
+  * @param  _ulTimer_Clock: The timer clock according to Hz
+  *			_ulFrequency: The frequency of PWM signal according to Hz
+  *			_xTimerIs32bit: The timer width
+  * @retval PWM frequency according to Hz
+  */
+static double Linear_Search(uint32_t _ulTimer_Clock, uint32_t _ulFrequency, bool _xTimerIs32bit)
+{
+	uint64_t Capacity = _xTimerIs32bit ? 0xFFFFFFFF : 0xFFFF;
+	uint64_t Prescaler = 0;
+	uint64_t Period = 0;
+
+	do
+	{
+		Period = _ulTimer_Clock / ((Prescaler + 1) * _ulFrequency);	//Calculate the timer period value
+		Prescaler++;
+	} while (Period > Capacity);
+	return (double)_ulTimer_Clock / ((double)Prescaler * Period);	//Prescaler + 1 and Period + 1 of the registers
+}
+
+/**
+  * @brief  This function prints the time and the frequency error of Timer_Solve and the linear search for the PWM
+  *			frequencies from 1 Hz to 1/10 of the timer clock (1, 2, 3, 5, 7 steps of each decade)
+  * @param  _pxPWM: The PWM object which solves the frequencies. Its timer is not changed
+  *			_ulTimer_Clock: The timer clock according to Hz
+  *			_ulIterations: The number of calls for each frequency
+  * @retval None
+  */
+static void Solver_Sweep(Hardware_PWM* _pxPWM, uint32_t _ulTimer_Clock, uint32_t _ulIterations)
+{
+	static const uint32_t Steps[5] = {1, 2, 3, 5, 7};
+	std::chrono::steady_clock::time_point Start;
+	volatile double Sink = 0;
+	double Solve_Time = 0;
+	double Search_Time = 0;
+	double Solve_Frequency = 0;
+	double Search_Frequency = 0;
+
+	printf("\n%-12s %14s %14s %14s %14s\n", "Frequency", "Solve nS", "Solve ppm", "Search nS", "Search ppm");
+	for (uint64_t Decade = 1; Decade < (_ulTimer_Clock / 10); Decade *= 10)
+	{
+		for (uint8_t i = 0; i < 5; i++)
+		{
+			uint32_t Frequency = (uint32_t)(Decade * Steps[i]);
+
+			if (Frequency >= (_ulTimer_Clock / 10))
+			{
+				break;
+			}
+			Start = std::chrono::steady_clock::now();
+			for (uint32_t j = 0; j < _ulIterations; j++)
+			{
+				Sink = _pxPWM->Get_Solved_Frequency(Frequency);
+			}
+			Solve_Time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count() / _ulIterations;
+			Solve_Frequency = Sink;
+
+			Start = std::chrono::steady_clock::now();
+			for (uint32_t j = 0; j < _ulIterations; j++)
+			{
+				Sink = Linear_Search(_ulTimer_Clock, Frequency, false);
+			}
+			Search_Time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count() / _ulIterations;
+			Search_Frequency = Sink;
+
+			printf("%-12u %14.1f %14.2f %14.1f %14.2f\n", Frequency, Solve_Time, ((Solve_Frequency - Frequency) * 1e6) / Frequency,
+				   Search_Time, ((Search_Frequency - Frequency) * 1e6) / Frequency);
+		}
+	}
+}
+
+/**
+  * @brief  This function prints the error of the average dutycycle which is generated by the first and second order
+  *			sigma-delta dithering. For each fractional dutycycle (1000 ticks + Fraction / 256), the Capture Compare
+  *			Register of channel 1 is averaged over 100 and 1000 update events.
+  * @param  _pxPWM: The PWM object. Its channel 1 should be running
+  * @retval None
+  */
+static void Dither_Report(Hardware_PWM* _pxPWM)
+{
+	static const uint16_t Fractions[] = {1, 16, 32, 48, 64, 85, 96, 112, 128, 144, 160, 171, 192, 208, 224, 240, 255};
+	static const uint32_t Windows[2] = {100, 1000};
+	uint32_t Target = 0;
+	uint64_t Sum = 0;
+	double Error[2][2];
+
+	printf("\n%-12s %14s %14s %14s %14s\n", "Fraction", "Order1 100", "Order1 1000", "Order2 100", "Order2 1000");
+	for (uint8_t i = 0; i < (sizeof(Fractions) / sizeof(Fractions[0])); i++)
+	{
+		Target = (1000 << 8) + Fractions[i];
+		for (uint8_t Order = 1; Order <= 2; Order++)
+		{
+			for (uint8_t j = 0; j < 2; j++)
+			{
+				_pxPWM->Start_Dithering(Order, true);	//It clears the errors of modulator
+				_pxPWM->Set_DutyCycle_HighRes_Q8(TIM_CHANNEL_1, Target);
+				Sum = 0;
+				for (uint32_t k = 0; k < Windows[j]; k++)
+				{
+					_pxPWM->Update_Event_Handler();
+					Sum += TIM1->CCR1;
+				}
+				Error[Order - 1][j] = ((double)Sum / Windows[j]) - (Target / 256.0);	//According to timer ticks
+				_pxPWM->Stop_Dithering();
+			}
+		}
+		printf("%-12u %14.6f %14.6f %14.6f %14.6f\n", Fractions[i], Error[0][0], Error[0][1], Error[1][0], Error[1][1]);
+	}
+}
+
+/**
+  * @brief  This function prints the cost of Software_PWM::Compare_Event_Handler against the channel count, from 1 to
+  *			SOFTWARE_PWM_CHANNELS. The pins are shared by two ports and each channel has a different dutycycle, so a
+  *			period has one interrupt for the rising edges and one interrupt for each falling edge. The counter is
+  *			moved to each compare value before the interrupt, like the timer.
+  * @param  _pxTimer: The timer handle of software channels. Its compare channel 1 is used
+  *			_ulIterations: The number of simulated periods for each channel count
+  * @retval None
+  */
+static void Software_Sweep(TIM_HandleTypeDef* _pxTimer, uint32_t _ulIterations)
+{
+	Software_Pin_Type Pins[SOFTWARE_PWM_CHANNELS];
+	TIM_TypeDef* Timer = _pxTimer->Instance;
+	std::chrono::steady_clock::time_point Start;
+	double Time = 0;
+	uint64_t Interrupts = 0;
+
+	for (uint8_t i = 0; i < SOFTWARE_PWM_CHANNELS; i++)
+	{
+		Pins[i]._pxPort = (i & 1) ? GPIOB : GPIOA;
+		Pins[i]._usPin = (uint16_t)(1U << (i >> 1));
+	}
+
+	printf("\n%-12s %14s %14s %14s %14s\n", "Channels", "nS/interrupt", "Interrupts", "nS/period", "Writes/period");
+	for (uint8_t Count = 1; Count <= SOFTWARE_PWM_CHANNELS; Count++)
+	{
+		Software_PWM xSoftware(_pxTimer, TIM_CHANNEL_1, Pins, Count);
+
+		for (uint8_t i = 0; i < Count; i++)
+		{
+			xSoftware.Start_PWM(i, (100.0 * (i + 1)) / (Count + 1));
+		}
+		Timer->CNT = 0;
+		xSoftware.Compare_Event_Handler();	//The new schedule is used from slot 0
+		do
+		{
+			Timer->CNT = Timer->CCR1;
+			xSoftware.Compare_Event_Handler();
+		} while (Timer->CCR1 != 0);
+
+		Interrupts = 0;
+		Host_Reset_Counters();
+		Start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < _ulIterations; i++)
+		{
+			do
+			{
+				Timer->CNT = Timer->CCR1;
+				xSoftware.Compare_Event_Handler();
+				Interrupts++;
+			} while (Timer->CCR1 != 0);
+		}
+		Time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count();
+
+		printf("%-12u %14.1f %14.2f %14.1f %14.2f\n", Count, Time / Interrupts, (double)Interrupts / _ulIterations,
+			   Time / _ulIterations, (double)(xHost_Counters.ulWrites - Interrupts) / _ulIterations);	//Without the counter writes of this loop
+	}
+}
+
+static void Stream_Fill(uint32_t* _pulFrames, uint16_t _usFrameCount, void* _pvContext)
+{
+	(void)_pvContext;
+	for (uint16_t i = 0; i < (_usFrameCount * 4); i++)
+	{
+		_pulFrames[i] = i;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t Iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 100000;
+	Phase_Accumulator_Type Phase = {0, Phase_Step(50, 20000)};
+	Channel_Edges_Type Edges;
+	ADC_Trigger_Type Trigger = {TIM_CHANNEL_4, TriggerHighCenter, TIM_CHANNEL_1, 0, 0};
+	const double Duties[4] = {10, 20, 30, 40};
+	const uint32_t Ticks[4] = {1000, 2000, 3000, 4000};
+
+	Host_Reset();
+	xTimer_DMA.Init.Mode = DMA_CIRCULAR;
+	Host_Timer_Handle_Init(&xTimer, TIM1, &xTimer_DMA);
+	xChannels.Channel4 = Disable;
+	Hardware_PWM xPWM(&xTimer, &xChannels, &xSpecs);
+
+	printf("%-44s %10s %10s %10s %10s\n", "Function", "nS/call", "Reads", "Writes", "HAL calls");
+	Measure("Hardware_PWM (constructor)", (Iterations / 100) + 1, [&](uint32_t i) { (void)i; Hardware_PWM xOther(&xTimer, &xChannels, &xSpecs); });
+	Measure("Start_PWM", Iterations, [&](uint32_t i) { xPWM.Start_PWM(TIM_CHANNEL_1, (i & 1) ? 25 : 75); });
+	Measure("Stop_PWM + Start_PWM", Iterations, [&](uint32_t i) { xPWM.Stop_PWM(TIM_CHANNEL_2); xPWM.Start_PWM(TIM_CHANNEL_2, (i & 1) ? 25 : 75); });
+	Measure("Change_DutyCycle", Iterations, [&](uint32_t i) { xPWM.Change_DutyCycle(TIM_CHANNEL_1, (i & 1) ? 25 : 75); });
+	Measure("Change_DutyCycle (same value)", Iterations, [&](uint32_t i) { (void)i; xPWM.Change_DutyCycle(TIM_CHANNEL_1, 50); });
+	Measure("Stop_All_PWM + Start_All_PWM", Iterations, [&](uint32_t i) { xPWM.Stop_All_PWM(); xPWM.Start_All_PWM((i & 1) ? 25 : 75); });
+	Measure("Set_All_DutyCycle", Iterations, [&](uint32_t i) { (void)i; xPWM.Set_All_DutyCycle(Duties); });
+	Measure("Set_All_DutyCycle_Ticks", Iterations, [&](uint32_t i) { (void)i; xPWM.Set_All_DutyCycle_Ticks(Ticks); });
+	Measure("Begin_Update + End_Update", Iterations, [&](uint32_t i) { (void)i; xPWM.Begin_Update(); xPWM.End_Update(); });
+	Measure("Set_DutyCycle_Ticks", Iterations, [&](uint32_t i) { xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_1, i & 0x1FFF); });
+	Measure("Set_DutyCycle_Q15", Iterations, [&](uint32_t i) { xPWM.Set_DutyCycle_Q15(TIM_CHANNEL_1, (uint16_t)(i & 0x7FFF)); });
+	Measure("Set_DutyCycle_Q16", Iterations, [&](uint32_t i) { xPWM.Set_DutyCycle_Q16(TIM_CHANNEL_1, i & 0xFFFF); });
+	Measure("Set_DutyCycle_Table", Iterations, [&](uint32_t i) { xPWM.Set_DutyCycle_Table(TIM_CHANNEL_1, xSine_Table, i << 24); });
+	Measure("Step_3Phase_Table", Iterations, [&](uint32_t i) { (void)i; xPWM.Step_3Phase_Table(xSine_Table, &Phase); });
+	Measure("Change_Frequency", (Iterations / 10) + 1, [&](uint32_t i) { xPWM.Change_Frequency((i & 1) ? 20000 : 25000); });
+	xPWM.Start_All_PWM(50);
+	Measure("Change_Frequency_Seamless", Iterations, [&](uint32_t i) { xPWM.Change_Frequency_Seamless((i & 1) ? 20000 : 25000); });
+	Measure("Get_Actual_Frequency", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Get_Actual_Frequency(); });
+	Measure("Get_Period", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Get_Period(); });
+	Measure("Get_DeadTime", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Get_DeadTime(); });
+	Measure("Get_Channel_Edges", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Get_Channel_Edges(TIM_CHANNEL_1, &Edges); });
+	Measure("Set_Update_Rate", Iterations, [&](uint32_t i) { xPWM.Set_Update_Rate((i & 1) + 1); });
+	xPWM.Set_Update_Rate(1);
+	Measure("Invalidate_Timer_Clock + Seamless", Iterations, [&](uint32_t i) { xPWM.Invalidate_Timer_Clock(); xPWM.Change_Frequency_Seamless((i & 1) ? 20000 : 25000); });
+	Measure("Update_Event_Handler (idle)", Iterations, [&](uint32_t i) { (void)i; xPWM.Update_Event_Handler(); });
+
+	Static_PWM_Type xStatic(xPWM.Get_Period());
+	Measure("Hardware_PWM_Static::Change_DutyCycle", Iterations, [&](uint32_t i) { Size_Static_Change_DutyCycle(&xStatic, TIM_CHANNEL_1, (i & 1) ? 25 : 75); });
+	Measure("Hardware_PWM_Static::Start_All_PWM", Iterations, [&](uint32_t i) { Size_Static_Start_All_PWM(&xStatic, (i & 1) ? 25 : 75); });
+	Measure("Hardware_PWM_Static::Set_DutyCycle_Ticks", Iterations, [&](uint32_t i) { Size_Static_Set_DutyCycle_Ticks(&xStatic, i & 0x1FFF); });
+	xPWM.Start_All_PWM(50);
+
+	xPWM.Start_Command_Queue();
+	Measure("Post_DutyCycle + Update_Event_Handler", Iterations, [&](uint32_t i) { xPWM.Post_DutyCycle(TIM_CHANNEL_1, (i & 1) ? 25 : 75); xPWM.Update_Event_Handler(); });
+	Measure("Post_DutyCycle_Q16 + Update_Event_Handler", Iterations, [&](uint32_t i) { xPWM.Post_DutyCycle_Q16(TIM_CHANNEL_1, (i & 1) ? 0x4000 : 0xC000); xPWM.Update_Event_Handler(); });
+	Measure("Post_Frequency + Update_Event_Handler", Iterations, [&](uint32_t i) { xPWM.Post_Frequency((i & 1) ? 20000 : 25000); xPWM.Update_Event_Handler(); });
+	xPWM.Stop_Command_Queue();
+
+	xPWM.Start_Dithering(2, true);
+	Measure("Set_DutyCycle_HighRes_Q8", Iterations, [&](uint32_t i) { xPWM.Set_DutyCycle_HighRes_Q8(TIM_CHANNEL_1, 1000 * 256 + (i & 0xFF)); });
+	Measure("Set_DutyCycle_HighRes (percent)", Iterations, [&](uint32_t i) { xPWM.Set_DutyCycle_HighRes(TIM_CHANNEL_1, 25.0 + ((i & 0xFF) / 1024.0)); });
+	Measure("Update_Event_Handler (dithering)", Iterations, [&](uint32_t i) { (void)i; xPWM.Update_Event_Handler(); });
+	xPWM.Stop_Dithering();
+
+#if defined(TIM_OCMODE_COMBINED_PWM1)
+	Measure("Set_Phase_Degrees + Update_Event", Iterations, [&](uint32_t i) { xPWM.Set_Phase_Degrees(TIM_CHANNEL_3, (i & 1) ? 90 : 180, 50); xPWM.Update_Event_Handler(); });
+#endif
+
+	Measure("Start_ADC_Trigger + Stop", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Start_ADC_Trigger(&Trigger); xPWM.Stop_ADC_Trigger(); });
+	(void)xPWM.Start_ADC_Trigger(&Trigger);
+	Measure("Update_ADC_Trigger", Iterations, [&](uint32_t i) { (void)i; xPWM.Update_ADC_Trigger(); });
+	xPWM.Stop_ADC_Trigger();
+
+	Measure("Get_Break_Status", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Get_Break_Status(); });
+	Measure("Get_Break_Count", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Get_Break_Count(); });
+	Measure("Break_Event_Handler", Iterations, [&](uint32_t i) { (void)i; xPWM.Break_Event_Handler(); });
+	Measure("Break_Recover", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Break_Recover(); });
+
+	Measure("Spread_Spectrum_Build (64 frames)", (Iterations / 100) + 1, [&](uint32_t i) { (void)i; xPWM.Spread_Spectrum_Build(ulFrames, 64, TriangleProfile, 2.0); });
+	Measure("Start_Spread_Spectrum + Stop", Iterations, [&](uint32_t i) { (void)i; xPWM.Start_Spread_Spectrum(ulFrames, 64); xPWM.Stop_Spread_Spectrum(); });
+	Measure("Ramp_Build_DutyCycle (64 frames)", (Iterations / 100) + 1, [&](uint32_t i) { (void)i; (void)xPWM.Ramp_Build_DutyCycle(ulFrames, 64, TIM_CHANNEL_1, 80, 10, SCurveRamp); });
+	Measure("Ramp_Build_Frequency (64 frames)", (Iterations / 100) + 1, [&](uint32_t i) { (void)i; (void)xPWM.Ramp_Build_Frequency(ulFrames, 64, 25000, 10, LinearRamp); });
+	Measure("Start_Streaming + Stop", Iterations, [&](uint32_t i) { (void)i; xPWM.Start_Streaming(ulStream, 16, Stream_Fill, NULL); xPWM.Stop_Streaming(); });
+	xPWM.Start_Streaming(ulStream, 16, NULL, NULL);
+	Measure("Stream_Get_Free_Half + Commit", Iterations, [&](uint32_t i) { (void)i; uint32_t* Half = xPWM.Stream_Get_Free_Half(); if (Half != NULL) { xPWM.Stream_Commit_Half(Half); } });
+	Measure("Get_Stream_Underruns", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Get_Stream_Underruns(); });
+	xPWM.Stop_Streaming();
+
+	Measure("Pulse_Ramp_Build (8 segments)", Iterations, [&](uint32_t i) { (void)i; xPWM.Pulse_Ramp_Build(xSegments, 8, 1000, 20000, 1000); });
+	Measure("Start_Pulse_Train + Stop", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Start_Pulse_Train(TIM_CHANNEL_1, 100, 50); xPWM.Stop_Pulse_Train(); });
+	Measure("Pulse_Train_Is_Running", Iterations, [&](uint32_t i) { (void)i; (void)xPWM.Pulse_Train_Is_Running(); });
+
+	static const Software_Pin_Type Pins[4] = {{GPIOA, GPIO_PIN_0}, {GPIOA, GPIO_PIN_1}, {GPIOB, GPIO_PIN_2}, {GPIOB, GPIO_PIN_3}};
+	static TIM_HandleTypeDef xSoftware_Timer;
+	Host_Timer_Handle_Init(&xSoftware_Timer, TIM2, NULL);
+	TIM2->ARR = 8499;
+	Software_PWM xSoftware(&xSoftware_Timer, TIM_CHANNEL_1, Pins, 4);
+	xSoftware.Start_All_PWM(50);
+	Measure("Software_PWM::Change_DutyCycle", Iterations, [&](uint32_t i) { xSoftware.Change_DutyCycle((uint8_t)(i & 3), (i & 4) ? 25 : 75); });
+	Measure("Software_PWM::Compare_Event_Handler", Iterations, [&](uint32_t i) { TIM2->CNT = (i * 1000) % 8500; xSoftware.Compare_Event_Handler(); });
+
+	Solver_Sweep(&xPWM, HAL_RCC_GetPCLK2Freq(), Iterations);
+	Dither_Report(&xPWM);
+	Software_Sweep(&xSoftware_Timer, Iterations / 10);
+
+	return 0;
+}
+/*****END OF FILE*****/
@@ -0,0 +1,587 @@
+/**
+  ******************************************************************************
+  * @file    Host_HAL.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Host model of STM32G4 timers and the HAL functions which are used
+  *          by Hardware_PWM. The registers keep their preload and active
+  *          (shadow) values, so tests can check what is applied in each update
+  *          event. The update DMA request plays burst transfers like the
+  *          hardware and calls the DMA callbacks.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <string.h>
+
+/* Types ---------------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t ulARR;					//Active auto reload value
+	uint32_t ulPSC;					//Active prescaler value
+	uint32_t ulRCR;					//Repetition counter value of the current update period
+	uint32_t ulCCR[4];				//Active compare values
+	uint32_t ulRepetition;			//Down counter of the repetition counter
+	TIM_HandleTypeDef* pxHandle;	//The handle which owns the update DMA request
+}Host_Shadow_Type;
+
+/* Variables -----------------------------------------------------------------*/
+Host_Counters_Type xHost_Counters;
+TIM_TypeDef xHost_Timers[Host_Timer_Count];
+GPIO_TypeDef xHost_Ports[2];
+uint32_t ulHost_PRIMASK;
+
+static Host_Shadow_Type xHost_Shadows[Host_Timer_Count];
+static uint32_t ulHost_HCLK = 170000000;
+static uint32_t ulHost_PCLK1 = 170000000;
+static uint32_t ulHost_PCLK2 = 170000000;
+
+/* Functions -----------------------------------------------------------------*/
+static Host_Shadow_Type* Host_Shadow(TIM_TypeDef* _pxTimer)
+{
+	return &xHost_Shadows[_pxTimer - xHost_Timers];
+}
+
+static Host_Register* Host_Register_At(TIM_TypeDef* _pxTimer, uint32_t _ulIndex)
+{
+	return (&_pxTimer->CR1) + _ulIndex;
+}
+
+static uint32_t Host_Preload_Mask(TIM_TypeDef* _pxTimer)	//Bit n shows the compare register n is preloaded
+{
+	uint32_t Mask = 0;
+
+	Mask |= ((_pxTimer->CCMR1.ulValue & TIM_CCMR1_OC1PE) != 0) ? 0x01 : 0;
+	Mask |= ((_pxTimer->CCMR1.ulValue & TIM_CCMR1_OC2PE) != 0) ? 0x02 : 0;
+	Mask |= ((_pxTimer->CCMR2.ulValue & TIM_CCMR2_OC3PE) != 0) ? 0x04 : 0;
+	Mask |= ((_pxTimer->CCMR2.ulValue & TIM_CCMR2_OC4PE) != 0) ? 0x08 : 0;
+	return Mask;
+}
+
+/**
+  * @brief  This function plays one burst of the update DMA request
+  * @param  _pxTimer: The timer
+  * @retval None
+  */
+static void Host_DMA_Request(TIM_TypeDef* _pxTimer)
+{
+	TIM_HandleTypeDef* Handle = Host_Shadow(_pxTimer)->pxHandle;
+	DMA_HandleTypeDef* DMA = (Handle != NULL) ? Handle->hdma[TIM_DMA_ID_UPDATE] : NULL;
+	uint32_t Base = _pxTimer->DCR.ulValue & TIM_DCR_DBA;
+	uint32_t Length = ((_pxTimer->DCR.ulValue & TIM_DCR_DBL) >> 8) + 1;
+	uint32_t Half = 0;
+	uint32_t Before = 0;
+
+	if ((DMA == NULL) || (DMA->xHost_Running == false) || ((_pxTimer->DIER.ulValue & TIM_DIER_UDE) == 0))
+	{
+		return;
+	}
+
+	Half = DMA->ulHost_Length / 2;
+	Before = DMA->ulHost_Index;
+	for (uint32_t i = 0; (i < Length) && (DMA->ulHost_Index < DMA->ulHost_Length); i++)
+	{
+		Host_Register_At(_pxTimer, Base + i)->ulValue = DMA->pulHost_Source[DMA->ulHost_Index];	//DMA writes are not CPU accesses
+		DMA->ulHost_Index++;
+	}
+
+	if ((Before < Half) && (DMA->ulHost_Index >= Half) && (DMA->XferHalfCpltCallback != NULL))
+	{
+		DMA->XferHalfCpltCallback(DMA);
+	}
+	if (DMA->ulHost_Index >= DMA->ulHost_Length)
+	{
+		if (DMA->Init.Mode == DMA_CIRCULAR)
+		{
+			DMA->ulHost_Index = 0;
+		}
+		else
+		{
+			DMA->xHost_Running = false;
+		}
+		if (DMA->XferCpltCallback != NULL)
+		{
+			DMA->XferCpltCallback(DMA);
+		}
+	}
+}
+
+/**
+  * @brief  This function generates an update event. The preload registers are transferred to the active registers.
+  * @param  _pxTimer: The timer
+  *			_xSoftware: true for the UG bit. It does not set the flag and the DMA request if URS is set
+  * @retval None
+  */
+static void Host_Update_Event(TIM_TypeDef* _pxTimer, bool _xSoftware)
+{
+	Host_Shadow_Type* Shadow = Host_Shadow(_pxTimer);
+
+	Shadow->ulARR = _pxTimer->ARR.ulValue;
+	Shadow->ulPSC = _pxTimer->PSC.ulValue;
+	Shadow->ulRCR = _pxTimer->RCR.ulValue;
+	Shadow->ulRepetition = _pxTimer->RCR.ulValue;
+	for (uint8_t i = 0; i < 4; i++)
+	{
+		Shadow->ulCCR[i] = Host_Register_At(_pxTimer, 13 + i)->ulValue;
+	}
+
+	if ((_xSoftware == false) || ((_pxTimer->CR1.ulValue & TIM_CR1_URS) == 0))
+	{
+		_pxTimer->SR.ulValue |= TIM_SR_UIF;
+		Host_DMA_Request(_pxTimer);
+	}
+}
+
+Host_Register& Host_Register::operator=(uint32_t _ulValue)
+{
+	xHost_Counters.ulWrites++;
+	switch (this->ucKind)
+	{
+	case Host_Clear_Register:
+		this->ulValue &= _ulValue;
+		break;
+	case Host_Event_Register:
+		for (uint8_t i = 0; i < Host_Timer_Count; i++)
+		{
+			if ((this == &xHost_Timers[i].EGR) && ((_ulValue & TIM_EGR_UG) != 0))
+			{
+				xHost_Timers[i].CNT.ulValue = 0;
+				if ((xHost_Timers[i].CR1.ulValue & TIM_CR1_UDIS) == 0)
+				{
+					Host_Update_Event(&xHost_Timers[i], true);
+				}
+			}
+		}
+		break;
+	case Host_Set_Reset_Register:
+		for (uint8_t i = 0; i < 2; i++)
+		{
+			if (this == &xHost_Ports[i].BSRR)
+			{
+				xHost_Ports[i].ODR.ulValue = (xHost_Ports[i].ODR.ulValue & ~(_ulValue >> 16)) | (_ulValue & 0xFFFF);
+			}
+		}
+		break;
+	default:
+		this->ulValue = _ulValue;
+		break;
+	}
+	return *this;
+}
+
+/**
+  * @brief  This function resets all peripherals, clocks and counters
+  * @param  None
+  * @retval None
+  */
+void Host_Reset(void)
+{
+	memset((void*)xHost_Timers, 0, sizeof(xHost_Timers));
+	memset((void*)xHost_Ports, 0, sizeof(xHost_Ports));
+	memset((void*)xHost_Shadows, 0, sizeof(xHost_Shadows));
+	for (uint8_t i = 0; i < Host_Timer_Count; i++)
+	{
+		xHost_Timers[i].SR.ucKind = Host_Clear_Register;
+		xHost_Timers[i].EGR.ucKind = Host_Event_Register;
+		xHost_Timers[i].ARR.ulValue = 0xFFFF;
+		xHost_Shadows[i].ulARR = 0xFFFF;
+	}
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		xHost_Ports[i].BSRR.ucKind = Host_Set_Reset_Register;
+	}
+	ulHost_PRIMASK = 0;
+	Host_Set_Clocks(170000000, 170000000, 170000000);
+	Host_Reset_Counters();
+}
+
+void Host_Set_Clocks(uint32_t _ulHCLK, uint32_t _ulPCLK1, uint32_t _ulPCLK2)
+{
+	ulHost_HCLK = _ulHCLK;
+	ulHost_PCLK1 = _ulPCLK1;
+	ulHost_PCLK2 = _ulPCLK2;
+}
+
+void Host_Reset_Counters(void)
+{
+	memset(&xHost_Counters, 0, sizeof(xHost_Counters));
+}
+
+/**
+  * @brief  This function initializes a timer handle like CubeMX. The DMA handle is linked to the update DMA request
+  * @param  _pxHandle: The timer handle
+  *			_pxInstance: The timer, for example TIM1
+  *			_pxDMA: The DMA handle of update request. It can be NULL
+  * @retval None
+  */
+void Host_Timer_Handle_Init(TIM_HandleTypeDef* _pxHandle, TIM_TypeDef* _pxInstance, DMA_HandleTypeDef* _pxDMA)
+{
+	memset(_pxHandle, 0, sizeof(*_pxHandle));
+	_pxHandle->Instance = _pxInstance;
+	_pxHandle->hdma[TIM_DMA_ID_UPDATE] = _pxDMA;
+	if (_pxDMA != NULL)
+	{
+		_pxDMA->Parent = _pxHandle;
+		_pxDMA->xHost_Running = false;
+	}
+	Host_Shadow(_pxInstance)->pxHandle = _pxHandle;
+}
+
+/**
+  * @brief  This function models the counter overflow (or underflow in center aligned mode) of a running timer
+  * @param  _pxTimer: The timer
+  * @retval true if an update event is generated
+  */
+bool Host_Timer_Overflow(TIM_TypeDef* _pxTimer)
+{
+	Host_Shadow_Type* Shadow = Host_Shadow(_pxTimer);
+
+	if ((_pxTimer->CR1.ulValue & TIM_CR1_CEN) == 0)
+	{
+		return false;
+	}
+
+	_pxTimer->CNT.ulValue = 0;
+	if (Shadow->ulRepetition != 0)
+	{
+		Shadow->ulRepetition--;
+		return false;
+	}
+	if ((_pxTimer->CR1.ulValue & TIM_CR1_UDIS) != 0)
+	{
+		return false;
+	}
+
+	Host_Update_Event(_pxTimer, false);
+	if ((_pxTimer->CR1.ulValue & TIM_CR1_OPM) != 0)
+	{
+		_pxTimer->CR1.ulValue &= ~TIM_CR1_CEN;
+	}
+	return true;
+}
+
+uint32_t Host_Active_ARR(TIM_TypeDef* _pxTimer)
+{
+	return ((_pxTimer->CR1.ulValue & TIM_CR1_ARPE) != 0) ? Host_Shadow(_pxTimer)->ulARR : _pxTimer->ARR.ulValue;
+}
+
+uint32_t Host_Active_PSC(TIM_TypeDef* _pxTimer)
+{
+	return Host_Shadow(_pxTimer)->ulPSC;
+}
+
+uint32_t Host_Active_CCR(TIM_TypeDef* _pxTimer, uint8_t _ucIndex)
+{
+	return ((Host_Preload_Mask(_pxTimer) & (1 << _ucIndex)) != 0) ? Host_Shadow(_pxTimer)->ulCCR[_ucIndex] : Host_Register_At(_pxTimer, 13 + _ucIndex)->ulValue;
+}
+
+uint32_t Host_Active_RCR(TIM_TypeDef* _pxTimer)
+{
+	return Host_Shadow(_pxTimer)->ulRCR;
+}
+
+/**
+  * @brief  This function models an active break input. The main output enable bit is cleared by the hardware
+  * @param  _pxTimer: The timer
+  * @retval None
+  */
+void Host_Break(TIM_TypeDef* _pxTimer)
+{
+	_pxTimer->BDTR.ulValue &= ~TIM_BDTR_MOE;
+	_pxTimer->SR.ulValue |= TIM_SR_BIF;
+}
+
+/* HAL -----------------------------------------------------------------------*/
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+	xHost_Counters.ulHAL_Calls++;
+	return ulHost_HCLK;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	xHost_Counters.ulHAL_Calls++;
+	return ulHost_PCLK1;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	xHost_Counters.ulHAL_Calls++;
+	return ulHost_PCLK2;
+}
+
+static void Host_Base_SetConfig(TIM_HandleTypeDef* htim)
+{
+	TIM_TypeDef* TIMx = htim->Instance;
+	uint32_t CR1 = TIMx->CR1;
+
+	CR1 &= ~(TIM_CR1_DIR | TIM_CR1_CMS | TIM_CR1_CKD | TIM_CR1_ARPE);
+	CR1 |= htim->Init.CounterMode | htim->Init.ClockDivision | htim->Init.AutoReloadPreload;
+	TIMx->CR1 = CR1;
+	TIMx->ARR = htim->Init.Period;
+	TIMx->PSC = htim->Init.Prescaler;
+	if (IS_TIM_REPETITION_COUNTER_INSTANCE(TIMx))
+	{
+		TIMx->RCR = htim->Init.RepetitionCounter;
+	}
+	TIMx->EGR = TIM_EGR_UG;
+	if ((TIMx->SR & TIM_SR_UIF) != 0)
+	{
+		TIMx->SR = ~TIM_SR_UIF;
+	}
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef* htim)
+{
+	xHost_Counters.ulHAL_Calls++;
+	Host_Base_SetConfig(htim);
+	htim->State = HAL_TIM_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef* htim)
+{
+	xHost_Counters.ulHAL_Calls++;
+	Host_Base_SetConfig(htim);
+	htim->State = HAL_TIM_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_Init(TIM_HandleTypeDef* htim)
+{
+	xHost_Counters.ulHAL_Calls++;
+	Host_Base_SetConfig(htim);
+	htim->State = HAL_TIM_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef* htim, TIM_ClockConfigTypeDef* sClockSourceConfig)
+{
+	xHost_Counters.ulHAL_Calls++;
+	if (sClockSourceConfig->ClockSource != TIM_CLOCKSOURCE_INTERNAL)
+	{
+		return HAL_ERROR;
+	}
+	htim->Instance->SMCR &= ~(TIM_SMCR_SMS | TIM_SMCR_TS | TIM_SMCR_ETF | TIM_SMCR_ETPS | TIM_SMCR_ECE | TIM_SMCR_ETP);
+	return HAL_OK;
+}
+
+static HAL_StatusTypeDef Host_OC_SetConfig(TIM_HandleTypeDef* htim, TIM_OC_InitTypeDef* sConfig, uint32_t Channel, bool _xPreload)
+{
+	TIM_TypeDef* TIMx = htim->Instance;
+	uint8_t Index = (uint8_t)(Channel >> 2);
+	Host_Register* CCMR = (Index < 2) ? &TIMx->CCMR1 : &TIMx->CCMR2;
+	uint32_t Shift = (Index & 1) * 8;
+	uint32_t CCER = 0;
+	uint32_t Mode = 0;
+
+	if (Index > 3)
+	{
+		return HAL_ERROR;
+	}
+
+	TIMx->CCER &= ~(TIM_CCER_CC1E << Channel);
+	CCER = TIMx->CCER;
+	CCER &= ~((TIM_CCER_CC1P | TIM_CCER_CC1NP | TIM_CCER_CC1NE) << Channel);
+	CCER |= (sConfig->OCPolarity | sConfig->OCNPolarity) << Channel;
+	if (IS_TIM_BREAK_INSTANCE(TIMx))
+	{
+		MODIFY_REG(TIMx->CR2, (TIM_CR2_OIS1 | TIM_CR2_OIS1N) << (Index * 2), (sConfig->OCIdleState | (sConfig->OCNIdleState << 1)) << (Index * 2));
+	}
+	Mode = *CCMR;
+	Mode &= ~((TIM_CCMR1_OC1M | TIM_CCMR1_OC1PE | TIM_CCMR1_OC1FE | 0x3U) << Shift);
+	Mode |= (sConfig->OCMode | sConfig->OCFastMode) << Shift;
+	if (_xPreload == true)
+	{
+		Mode |= TIM_CCMR1_OC1PE << Shift;
+	}
+	*CCMR = Mode;
+	*Host_Register_At(TIMx, 13 + Index) = sConfig->Pulse;
+	TIMx->CCER = CCER;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef* htim, TIM_OC_InitTypeDef* sConfig, uint32_t Channel)
+{
+	xHost_Counters.ulHAL_Calls++;
+	return Host_OC_SetConfig(htim, sConfig, Channel, true);
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef* htim, TIM_OC_InitTypeDef* sConfig, uint32_t Channel)
+{
+	xHost_Counters.ulHAL_Calls++;
+	return Host_OC_SetConfig(htim, sConfig, Channel, false);
+}
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef* htim, TIM_MasterConfigTypeDef* sMasterConfig)
+{
+	TIM_TypeDef* TIMx = htim->Instance;
+	uint32_t CR2 = TIMx->CR2;
+
+	xHost_Counters.ulHAL_Calls++;
+	if (IS_TIM_TRGO2_INSTANCE(TIMx))
+	{
+		CR2 = (CR2 & ~TIM_CR2_MMS2) | sMasterConfig->MasterOutputTrigger2;
+	}
+	CR2 = (CR2 & ~TIM_CR2_MMS) | sMasterConfig->MasterOutputTrigger;
+	TIMx->CR2 = CR2;
+	MODIFY_REG(TIMx->SMCR, TIM_SMCR_MSM, sMasterConfig->MasterSlaveMode);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_ConfigBreakDeadTime(TIM_HandleTypeDef* htim, TIM_BreakDeadTimeConfigTypeDef* sBreakDeadTimeConfig)
+{
+	uint32_t BDTR = 0;
+
+	xHost_Counters.ulHAL_Calls++;
+	BDTR |= sBreakDeadTimeConfig->DeadTime & TIM_BDTR_DTG;
+	BDTR |= sBreakDeadTimeConfig->LockLevel | sBreakDeadTimeConfig->OffStateIDLEMode | sBreakDeadTimeConfig->OffStateRunMode;
+	BDTR |= sBreakDeadTimeConfig->BreakState | sBreakDeadTimeConfig->BreakPolarity | sBreakDeadTimeConfig->AutomaticOutput;
+	BDTR |= (sBreakDeadTimeConfig->BreakFilter << TIM_BDTR_BKF_Pos) & TIM_BDTR_BKF;
+	BDTR |= sBreakDeadTimeConfig->Break2State | sBreakDeadTimeConfig->Break2Polarity;
+	BDTR |= (sBreakDeadTimeConfig->Break2Filter << TIM_BDTR_BK2F_Pos) & TIM_BDTR_BK2F;
+	htim->Instance->BDTR = BDTR;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_SlaveConfigSynchro(TIM_HandleTypeDef* htim, TIM_SlaveConfigTypeDef* sSlaveConfig)
+{
+	xHost_Counters.ulHAL_Calls++;
+	MODIFY_REG(htim->Instance->SMCR, TIM_SMCR_TS | TIM_SMCR_SMS, sSlaveConfig->InputTrigger | sSlaveConfig->SlaveMode);
+	return HAL_OK;
+}
+
+static void Host_Start(TIM_HandleTypeDef* htim, uint32_t _ulEnable)
+{
+	TIM_TypeDef* TIMx = htim->Instance;
+
+	TIMx->CCER |= _ulEnable;
+	if (IS_TIM_BREAK_INSTANCE(TIMx))
+	{
+		TIMx->BDTR |= TIM_BDTR_MOE;
+	}
+	if ((TIMx->SMCR & TIM_SMCR_SMS) != TIM_SLAVEMODE_TRIGGER)
+	{
+		TIMx->CR1 |= TIM_CR1_CEN;
+	}
+}
+
+static void Host_Stop(TIM_HandleTypeDef* htim, uint32_t _ulEnable)
+{
+	const uint32_t Outputs = 0x1111U | 0x0444U;	//CCxE and CCxNE bits
+	TIM_TypeDef* TIMx = htim->Instance;
+
+	TIMx->CCER &= ~_ulEnable;
+	if ((TIMx->CCER & Outputs) == 0)
+	{
+		if (IS_TIM_BREAK_INSTANCE(TIMx))
+		{
+			TIMx->BDTR &= ~TIM_BDTR_MOE;
+		}
+		TIMx->CR1 &= ~TIM_CR1_CEN;
+	}
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t Channel)
+{
+	xHost_Counters.ulHAL_Calls++;
+	Host_Start(htim, TIM_CCER_CC1E << Channel);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef* htim, uint32_t Channel)
+{
+	xHost_Counters.ulHAL_Calls++;
+	Host_Stop(htim, TIM_CCER_CC1E << Channel);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Start(TIM_HandleTypeDef* htim, uint32_t Channel)
+{
+	xHost_Counters.ulHAL_Calls++;
+	Host_Start(htim, TIM_CCER_CC1NE << Channel);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Stop(TIM_HandleTypeDef* htim, uint32_t Channel)
+{
+	xHost_Counters.ulHAL_Calls++;
+	Host_Stop(htim, TIM_CCER_CC1NE << Channel);
+	return HAL_OK;
+}
+
+static void Host_DMA_PeriodElapsedCplt(DMA_HandleTypeDef* hdma)
+{
+	TIM_HandleTypeDef* htim = (TIM_HandleTypeDef*)hdma->Parent;
+
+	if (hdma->Init.Mode == DMA_NORMAL)
+	{
+		htim->State = HAL_TIM_STATE_READY;
+	}
+	HAL_TIM_PeriodElapsedCallback(htim);
+}
+
+static void Host_DMA_PeriodElapsedHalfCplt(DMA_HandleTypeDef* hdma)
+{
+	HAL_TIM_PeriodElapsedHalfCpltCallback((TIM_HandleTypeDef*)hdma->Parent);
+}
+
+HAL_StatusTypeDef HAL_TIM_DMABurst_MultiWriteStart(TIM_HandleTypeDef* htim, uint32_t BurstBaseAddress, uint32_t BurstRequestSrc,
+												   uint32_t* BurstBuffer, uint32_t BurstLength, uint32_t DataLength)
+{
+	DMA_HandleTypeDef* DMA = htim->hdma[TIM_DMA_ID_UPDATE];
+
+	xHost_Counters.ulHAL_Calls++;
+	if ((DMA == NULL) || (BurstBuffer == NULL) || (DataLength == 0) || (DMA->xHost_Running == true))
+	{
+		return HAL_ERROR;
+	}
+	DMA->XferCpltCallback = Host_DMA_PeriodElapsedCplt;
+	DMA->XferHalfCpltCallback = Host_DMA_PeriodElapsedHalfCplt;
+	DMA->pulHost_Source = BurstBuffer;
+	DMA->ulHost_Length = DataLength;
+	DMA->ulHost_Index = 0;
+	DMA->xHost_Running = true;
+	htim->Instance->DCR = BurstBaseAddress | BurstLength;
+	htim->Instance->DIER |= BurstRequestSrc;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_DMABurst_WriteStop(TIM_HandleTypeDef* htim, uint32_t BurstRequestSrc)
+{
+	DMA_HandleTypeDef* DMA = htim->hdma[TIM_DMA_ID_UPDATE];
+
+	xHost_Counters.ulHAL_Calls++;
+	htim->Instance->DIER &= ~BurstRequestSrc;
+	if (DMA != NULL)
+	{
+		DMA->xHost_Running = false;
+	}
+	htim->State = HAL_TIM_STATE_READY;
+	return HAL_OK;
+}
+
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef* htim)
+{
+	(void)htim;
+	xHost_Counters.ulHAL_Calls++;
+}
+
+__attribute__((weak)) void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
+{
+	(void)htim;
+}
+
+__attribute__((weak)) void HAL_TIM_PeriodElapsedHalfCpltCallback(TIM_HandleTypeDef* htim)
+{
+	(void)htim;
+}
+
+void Error_Handler(void)
+{
+	xHost_Counters.ulErrors++;
+}
+/*****END OF FILE*****/
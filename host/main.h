@@ -0,0 +1,580 @@
+#pragma once
+/**
+  ******************************************************************************
+  * @file    main.h
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Host replacement of the CubeMX main.h for tests and benchmarks.
+  *          It declares a register accurate STM32G4 timer (TIM1/2/3/8/15/16/17),
+  *          the HAL functions which are used by Hardware_PWM and counters of
+  *          register accesses and HAL calls. Build with HARDWARE_PWM_HOST.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_MAIN_H
+#define HOST_MAIN_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Device --------------------------------------------------------------------*/
+#define STM32G4
+
+/* Register ------------------------------------------------------------------*/
+typedef enum
+{
+	Host_Normal_Register = 0,
+	Host_Clear_Register,		//rc_w0 bits, for example the status register. Writing 0 clears a bit and writing 1 has no effect
+	Host_Event_Register,		//Writing 1 generates an event, for example the event generation register. It is read as 0
+	Host_Set_Reset_Register		//Bit set/reset register of a GPIO port. It changes the output data register
+}Host_Register_KindType;
+
+typedef struct
+{
+	uint32_t ulReads;		//The number of register reads
+	uint32_t ulWrites;		//The number of register writes. A read-modify-write is one read and one write
+	uint32_t ulHAL_Calls;	//The number of HAL function calls
+	uint32_t ulErrors;		//The number of Error_Handler calls
+}Host_Counters_Type;
+
+extern Host_Counters_Type xHost_Counters;
+
+/**
+  * @brief  A 32 bit peripheral register. It counts the accesses and models the write semantics of its kind
+  */
+struct Host_Register
+{
+	volatile uint32_t ulValue;
+	uint8_t ucKind;
+
+	inline operator uint32_t() const
+	{
+		xHost_Counters.ulReads++;
+		return this->ulValue;
+	}
+
+	Host_Register& operator=(uint32_t _ulValue);
+
+	inline Host_Register& operator=(const Host_Register& _xRegister)
+	{
+		return (*this = (uint32_t)_xRegister);
+	}
+
+	inline Host_Register& operator|=(uint32_t _ulValue)
+	{
+		return (*this = ((uint32_t)*this | _ulValue));
+	}
+
+	inline Host_Register& operator&=(uint32_t _ulValue)
+	{
+		return (*this = ((uint32_t)*this & _ulValue));
+	}
+
+	inline Host_Register& operator^=(uint32_t _ulValue)
+	{
+		return (*this = ((uint32_t)*this ^ _ulValue));
+	}
+};
+
+#define __IO
+#define SET_BIT(REG, BIT)						((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)						((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)						((REG) & (BIT))
+#define WRITE_REG(REG, VAL)						((REG) = (VAL))
+#define READ_REG(REG)							((uint32_t)(REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)		WRITE_REG((REG), ((((uint32_t)(REG)) & (~(CLEARMASK))) | (SETMASK)))
+
+typedef enum
+{
+	RESET = 0,
+	SET = !RESET
+}FlagStatus, ITStatus;
+
+typedef struct
+{
+	Host_Register CR1;
+	Host_Register CR2;
+	Host_Register SMCR;
+	Host_Register DIER;
+	Host_Register SR;
+	Host_Register EGR;
+	Host_Register CCMR1;
+	Host_Register CCMR2;
+	Host_Register CCER;
+	Host_Register CNT;
+	Host_Register PSC;
+	Host_Register ARR;
+	Host_Register RCR;
+	Host_Register CCR1;
+	Host_Register CCR2;
+	Host_Register CCR3;
+	Host_Register CCR4;
+	Host_Register BDTR;
+	Host_Register CCR5;
+	Host_Register CCR6;
+	Host_Register CCMR3;
+	Host_Register DTR2;
+	Host_Register ECR;
+	Host_Register TISEL;
+	Host_Register AF1;
+	Host_Register AF2;
+	Host_Register OR;
+	Host_Register DCR;
+	Host_Register DMAR;
+}TIM_TypeDef;
+
+typedef struct
+{
+	Host_Register MODER;
+	Host_Register ODR;
+	Host_Register BSRR;
+}GPIO_TypeDef;
+
+/* Timer register bits (STM32G4) ---------------------------------------------*/
+#define TIM_CR1_CEN					0x00000001U
+#define TIM_CR1_UDIS				0x00000002U
+#define TIM_CR1_URS					0x00000004U
+#define TIM_CR1_OPM					0x00000008U
+#define TIM_CR1_DIR					0x00000010U
+#define TIM_CR1_CMS					0x00000060U
+#define TIM_CR1_ARPE				0x00000080U
+#define TIM_CR1_CKD					0x00000300U
+
+#define TIM_CR2_MMS					0x00000070U
+#define TIM_CR2_OIS1_Pos			8U
+#define TIM_CR2_OIS1				0x00000100U
+#define TIM_CR2_OIS1N				0x00000200U
+#define TIM_CR2_OIS2				0x00000400U
+#define TIM_CR2_OIS2N				0x00000800U
+#define TIM_CR2_OIS3				0x00001000U
+#define TIM_CR2_OIS3N				0x00002000U
+#define TIM_CR2_OIS4				0x00004000U
+#define TIM_CR2_MMS2				0x00F00000U
+
+#define TIM_SMCR_SMS				0x00010007U
+#define TIM_SMCR_TS					0x00300070U
+#define TIM_SMCR_MSM				0x00000080U
+#define TIM_SMCR_ETF				0x00000F00U
+#define TIM_SMCR_ETPS				0x00003000U
+#define TIM_SMCR_ETPS_0				0x00001000U
+#define TIM_SMCR_ECE				0x00004000U
+#define TIM_SMCR_ETP				0x00008000U
+
+#define TIM_DIER_UIE				0x00000001U
+#define TIM_DIER_CC1IE				0x00000002U
+#define TIM_DIER_CC2IE				0x00000004U
+#define TIM_DIER_CC3IE				0x00000008U
+#define TIM_DIER_CC4IE				0x00000010U
+#define TIM_DIER_BIE				0x00000080U
+#define TIM_DIER_UDE				0x00000100U
+
+#define TIM_SR_UIF					0x00000001U
+#define TIM_SR_CC1IF				0x00000002U
+#define TIM_SR_CC2IF				0x00000004U
+#define TIM_SR_CC3IF				0x00000008U
+#define TIM_SR_CC4IF				0x00000010U
+#define TIM_SR_BIF					0x00000080U
+#define TIM_SR_B2IF					0x00000100U
+
+#define TIM_EGR_UG					0x00000001U
+
+#define TIM_CCMR1_OC1FE				0x00000004U
+#define TIM_CCMR1_OC1PE				0x00000008U
+#define TIM_CCMR1_OC1M				0x00010070U
+#define TIM_CCMR1_OC2FE				0x00000400U
+#define TIM_CCMR1_OC2PE				0x00000800U
+#define TIM_CCMR1_OC2M				0x01007000U
+#define TIM_CCMR2_OC3PE				0x00000008U
+#define TIM_CCMR2_OC3M				0x00010070U
+#define TIM_CCMR2_OC4PE				0x00000800U
+#define TIM_CCMR2_OC4M				0x01007000U
+
+#define TIM_CCER_CC1E				0x00000001U
+#define TIM_CCER_CC1P				0x00000002U
+#define TIM_CCER_CC1NE				0x00000004U
+#define TIM_CCER_CC1NP				0x00000008U
+
+#define TIM_BDTR_DTG				0x000000FFU
+#define TIM_BDTR_LOCK				0x00000300U
+#define TIM_BDTR_OSSI				0x00000400U
+#define TIM_BDTR_OSSR				0x00000800U
+#define TIM_BDTR_BKE				0x00001000U
+#define TIM_BDTR_BKP				0x00002000U
+#define TIM_BDTR_AOE				0x00004000U
+#define TIM_BDTR_MOE				0x00008000U
+#define TIM_BDTR_BKF				0x000F0000U
+#define TIM_BDTR_BKF_Pos			16U
+#define TIM_BDTR_BK2F				0x00F00000U
+#define TIM_BDTR_BK2F_Pos			20U
+#define TIM_BDTR_BK2E				0x01000000U
+#define TIM_BDTR_BK2P				0x02000000U
+
+#define TIM_RCR_REP					0x0000FFFFU
+
+#define TIM_DCR_DBA					0x0000001FU
+#define TIM_DCR_DBL					0x00001F00U
+
+/* Timer HAL constants -------------------------------------------------------*/
+#define TIM_CHANNEL_1				0x00000000U
+#define TIM_CHANNEL_2				0x00000004U
+#define TIM_CHANNEL_3				0x00000008U
+#define TIM_CHANNEL_4				0x0000000CU
+
+#define TIM_COUNTERMODE_UP				0x00000000U
+#define TIM_COUNTERMODE_DOWN			TIM_CR1_DIR
+#define TIM_COUNTERMODE_CENTERALIGNED1	0x00000020U
+#define TIM_COUNTERMODE_CENTERALIGNED2	0x00000040U
+#define TIM_COUNTERMODE_CENTERALIGNED3	TIM_CR1_CMS
+
+#define TIM_CLOCKDIVISION_DIV1		0x00000000U
+#define TIM_CLOCKDIVISION_DIV2		0x00000100U
+#define TIM_CLOCKDIVISION_DIV4		0x00000200U
+
+#define TIM_AUTORELOAD_PRELOAD_DISABLE	0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_ENABLE	TIM_CR1_ARPE
+
+#define TIM_CLOCKSOURCE_INTERNAL	TIM_SMCR_ETPS_0
+
+#define TIM_OCMODE_TIMING			0x00000000U
+#define TIM_OCMODE_ACTIVE			0x00000010U
+#define TIM_OCMODE_INACTIVE			0x00000020U
+#define TIM_OCMODE_TOGGLE			0x00000030U
+#define TIM_OCMODE_FORCED_INACTIVE	0x00000040U
+#define TIM_OCMODE_FORCED_ACTIVE	0x00000050U
+#define TIM_OCMODE_PWM1				0x00000060U
+#define TIM_OCMODE_PWM2				0x00000070U
+#define TIM_OCMODE_COMBINED_PWM1	0x00010040U
+#define TIM_OCMODE_COMBINED_PWM2	0x00010050U
+
+#define TIM_OCPOLARITY_HIGH			0x00000000U
+#define TIM_OCNPOLARITY_HIGH		0x00000000U
+#define TIM_OCFAST_DISABLE			0x00000000U
+#define TIM_OCIDLESTATE_RESET		0x00000000U
+#define TIM_OCNIDLESTATE_RESET		0x00000000U
+
+#define TIM_TRGO_RESET				0x00000000U
+#define TIM_TRGO_ENABLE				0x00000010U
+#define TIM_TRGO_UPDATE				0x00000020U
+#define TIM_TRGO_OC1				0x00000030U
+#define TIM_TRGO_OC1REF				0x00000040U
+#define TIM_TRGO_OC2REF				0x00000050U
+#define TIM_TRGO_OC3REF				0x00000060U
+#define TIM_TRGO_OC4REF				0x00000070U
+
+#define TIM_TRGO2_RESET				0x00000000U
+#define TIM_TRGO2_OC1REF			0x00400000U
+#define TIM_TRGO2_OC2REF			0x00500000U
+#define TIM_TRGO2_OC3REF			0x00600000U
+#define TIM_TRGO2_OC4REF			0x00700000U
+
+#define TIM_MASTERSLAVEMODE_ENABLE	TIM_SMCR_MSM
+#define TIM_MASTERSLAVEMODE_DISABLE	0x00000000U
+
+#define TIM_SLAVEMODE_DISABLE		0x00000000U
+#define TIM_SLAVEMODE_TRIGGER		0x00000006U
+#define TIM_TS_ITR0					0x00000000U
+#define TIM_TS_ITR1					0x00000010U
+#define TIM_TS_ITR2					0x00000020U
+#define TIM_TS_ITR3					0x00000030U
+#define TIM_TRIGGERPOLARITY_RISING	0x00000000U
+#define TIM_TRIGGERPRESCALER_DIV1	0x00000000U
+
+#define TIM_DMABASE_CR1				0x00000000U
+#define TIM_DMABASE_ARR				0x0000000BU
+#define TIM_DMABASE_RCR				0x0000000CU
+#define TIM_DMABASE_CCR1			0x0000000DU
+#define TIM_DMABURSTLENGTH_1TRANSFER	0x00000000U
+#define TIM_DMABURSTLENGTH_2TRANSFERS	0x00000100U
+#define TIM_DMABURSTLENGTH_3TRANSFERS	0x00000200U
+#define TIM_DMABURSTLENGTH_4TRANSFERS	0x00000300U
+#define TIM_DMABURSTLENGTH_5TRANSFERS	0x00000400U
+#define TIM_DMABURSTLENGTH_6TRANSFERS	0x00000500U
+#define TIM_DMA_UPDATE				TIM_DIER_UDE
+#define TIM_DMA_ID_UPDATE			0U
+
+#define TIM_IT_UPDATE				TIM_DIER_UIE
+#define TIM_IT_CC1					TIM_DIER_CC1IE
+#define TIM_IT_CC2					TIM_DIER_CC2IE
+#define TIM_IT_CC3					TIM_DIER_CC3IE
+#define TIM_IT_CC4					TIM_DIER_CC4IE
+#define TIM_IT_BREAK				TIM_DIER_BIE
+#define TIM_FLAG_UPDATE				TIM_SR_UIF
+#define TIM_FLAG_CC1				TIM_SR_CC1IF
+#define TIM_FLAG_CC2				TIM_SR_CC2IF
+#define TIM_FLAG_CC3				TIM_SR_CC3IF
+#define TIM_FLAG_CC4				TIM_SR_CC4IF
+#define TIM_FLAG_BREAK				TIM_SR_BIF
+#define TIM_FLAG_BREAK2				TIM_SR_B2IF
+
+#define TIM_OSSR_ENABLE				TIM_BDTR_OSSR
+#define TIM_OSSR_DISABLE			0x00000000U
+#define TIM_OSSI_ENABLE				TIM_BDTR_OSSI
+#define TIM_OSSI_DISABLE			0x00000000U
+#define TIM_LOCKLEVEL_OFF			0x00000000U
+#define TIM_LOCKLEVEL_1				0x00000100U
+#define TIM_LOCKLEVEL_2				0x00000200U
+#define TIM_LOCKLEVEL_3				TIM_BDTR_LOCK
+#define TIM_BREAK_ENABLE			TIM_BDTR_BKE
+#define TIM_BREAK_DISABLE			0x00000000U
+#define TIM_BREAKPOLARITY_LOW		0x00000000U
+#define TIM_BREAKPOLARITY_HIGH		TIM_BDTR_BKP
+#define TIM_BREAK2_ENABLE			TIM_BDTR_BK2E
+#define TIM_BREAK2_DISABLE			0x00000000U
+#define TIM_BREAK2POLARITY_LOW		0x00000000U
+#define TIM_BREAK2POLARITY_HIGH		TIM_BDTR_BK2P
+#define TIM_AUTOMATICOUTPUT_ENABLE	TIM_BDTR_AOE
+#define TIM_AUTOMATICOUTPUT_DISABLE	0x00000000U
+
+/* HAL types -----------------------------------------------------------------*/
+typedef enum
+{
+	HAL_OK = 0,
+	HAL_ERROR,
+	HAL_BUSY,
+	HAL_TIMEOUT
+}HAL_StatusTypeDef;
+
+typedef enum
+{
+	HAL_TIM_STATE_RESET = 0,
+	HAL_TIM_STATE_READY,
+	HAL_TIM_STATE_BUSY
+}HAL_TIM_StateTypeDef;
+
+#define DMA_NORMAL					0x00000000U
+#define DMA_CIRCULAR				0x00000020U
+
+typedef struct
+{
+	uint32_t Mode;		//DMA_NORMAL or DMA_CIRCULAR
+}DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+	DMA_InitTypeDef Init;
+	void* Parent;
+	void (*XferCpltCallback)(struct __DMA_HandleTypeDef* hdma);
+	void (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef* hdma);
+	void (*XferErrorCallback)(struct __DMA_HandleTypeDef* hdma);
+	const uint32_t* pulHost_Source;		//Host model: the memory buffer of transfer
+	uint32_t ulHost_Length;				//Host model: the number of words of transfer
+	uint32_t ulHost_Index;				//Host model: the index of the next word
+	bool xHost_Running;					//Host model: the stream is enabled
+}DMA_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t Prescaler;
+	uint32_t CounterMode;
+	uint32_t Period;
+	uint32_t ClockDivision;
+	uint32_t RepetitionCounter;
+	uint32_t AutoReloadPreload;
+}TIM_Base_InitTypeDef;
+
+typedef struct
+{
+	TIM_TypeDef* Instance;
+	TIM_Base_InitTypeDef Init;
+	DMA_HandleTypeDef* hdma[7];
+	HAL_TIM_StateTypeDef State;
+}TIM_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t OCMode;
+	uint32_t Pulse;
+	uint32_t OCPolarity;
+	uint32_t OCNPolarity;
+	uint32_t OCFastMode;
+	uint32_t OCIdleState;
+	uint32_t OCNIdleState;
+}TIM_OC_InitTypeDef;
+
+typedef struct
+{
+	uint32_t ClockSource;
+	uint32_t ClockPolarity;
+	uint32_t ClockPrescaler;
+	uint32_t ClockFilter;
+}TIM_ClockConfigTypeDef;
+
+typedef struct
+{
+	uint32_t MasterOutputTrigger;
+	uint32_t MasterOutputTrigger2;
+	uint32_t MasterSlaveMode;
+}TIM_MasterConfigTypeDef;
+
+typedef struct
+{
+	uint32_t SlaveMode;
+	uint32_t InputTrigger;
+	uint32_t TriggerPolarity;
+	uint32_t TriggerPrescaler;
+	uint32_t TriggerFilter;
+}TIM_SlaveConfigTypeDef;
+
+typedef struct
+{
+	uint32_t OffStateRunMode;
+	uint32_t OffStateIDLEMode;
+	uint32_t LockLevel;
+	uint32_t DeadTime;
+	uint32_t BreakState;
+	uint32_t BreakPolarity;
+	uint32_t BreakFilter;
+	uint32_t BreakAFMode;
+	uint32_t Break2State;
+	uint32_t Break2Polarity;
+	uint32_t Break2Filter;
+	uint32_t Break2AFMode;
+	uint32_t AutomaticOutput;
+}TIM_BreakDeadTimeConfigTypeDef;
+
+/* Peripherals ---------------------------------------------------------------*/
+typedef enum
+{
+	Host_TIM1 = 0,
+	Host_TIM2,
+	Host_TIM3,
+	Host_TIM8,
+	Host_TIM15,
+	Host_TIM16,
+	Host_TIM17,
+	Host_Timer_Count
+}Host_Timer_IdType;
+
+extern TIM_TypeDef xHost_Timers[Host_Timer_Count];
+extern GPIO_TypeDef xHost_Ports[2];
+
+#define TIM1						(&xHost_Timers[Host_TIM1])
+#define TIM2						(&xHost_Timers[Host_TIM2])
+#define TIM3						(&xHost_Timers[Host_TIM3])
+#define TIM8						(&xHost_Timers[Host_TIM8])
+#define TIM15						(&xHost_Timers[Host_TIM15])
+#define TIM16						(&xHost_Timers[Host_TIM16])
+#define TIM17						(&xHost_Timers[Host_TIM17])
+#define GPIOA						(&xHost_Ports[0])
+#define GPIOB						(&xHost_Ports[1])
+
+/*The model timers have no constant address, so Hardware_PWM_Static uses this class instead of Timer_Address,
+  for example Hardware_PWM_Static<Host_Timer<Host_TIM1>, ...>*/
+template<Host_Timer_IdType Id>
+struct Host_Timer
+{
+	static inline TIM_TypeDef* Instance(void)
+	{
+		return &xHost_Timers[Id];
+	}
+};
+
+#define IS_TIM_BREAK_INSTANCE(INSTANCE)				(((INSTANCE) == TIM1) || ((INSTANCE) == TIM8) || ((INSTANCE) == TIM15) || \
+													 ((INSTANCE) == TIM16) || ((INSTANCE) == TIM17))
+#define IS_TIM_REPETITION_COUNTER_INSTANCE(INSTANCE)	IS_TIM_BREAK_INSTANCE(INSTANCE)
+#define IS_TIM_TRGO2_INSTANCE(INSTANCE)				(((INSTANCE) == TIM1) || ((INSTANCE) == TIM8))
+#define IS_TIM_32B_COUNTER_INSTANCE(INSTANCE)		((INSTANCE) == TIM2)
+
+#define GPIO_PIN_0					0x0001U
+#define GPIO_PIN_1					0x0002U
+#define GPIO_PIN_2					0x0004U
+#define GPIO_PIN_3					0x0008U
+#define GPIO_PIN_4					0x0010U
+#define GPIO_PIN_5					0x0020U
+#define GPIO_PIN_6					0x0040U
+#define GPIO_PIN_7					0x0080U
+#define GPIO_PIN_8					0x0100U
+#define GPIO_PIN_9					0x0200U
+#define GPIO_PIN_10					0x0400U
+#define GPIO_PIN_11					0x0800U
+#define GPIO_PIN_12					0x1000U
+#define GPIO_PIN_13					0x2000U
+#define GPIO_PIN_14					0x4000U
+#define GPIO_PIN_15					0x8000U
+
+/* HAL macros ----------------------------------------------------------------*/
+#define __HAL_TIM_ENABLE_IT(__HANDLE__, __INTERRUPT__)		((__HANDLE__)->Instance->DIER |= (__INTERRUPT__))
+#define __HAL_TIM_DISABLE_IT(__HANDLE__, __INTERRUPT__)		((__HANDLE__)->Instance->DIER &= ~(__INTERRUPT__))
+#define __HAL_TIM_GET_IT_SOURCE(__HANDLE__, __INTERRUPT__)	((((__HANDLE__)->Instance->DIER & (__INTERRUPT__)) == (__INTERRUPT__)) ? SET : RESET)
+#define __HAL_TIM_GET_FLAG(__HANDLE__, __FLAG__)			(((__HANDLE__)->Instance->SR & (__FLAG__)) == (__FLAG__))
+#define __HAL_TIM_CLEAR_FLAG(__HANDLE__, __FLAG__)			((__HANDLE__)->Instance->SR = ~(__FLAG__))
+#define __HAL_TIM_MOE_ENABLE(__HANDLE__)					((__HANDLE__)->Instance->BDTR |= (TIM_BDTR_MOE))
+#define __HAL_TIM_MOE_DISABLE_UNCONDITIONALLY(__HANDLE__)	((__HANDLE__)->Instance->BDTR &= ~(TIM_BDTR_MOE))
+#define __HAL_TIM_ENABLE_OCxPRELOAD(__HANDLE__, __CHANNEL__)	\
+	(((__CHANNEL__) == TIM_CHANNEL_1) ? ((__HANDLE__)->Instance->CCMR1 |= TIM_CCMR1_OC1PE) : \
+	 ((__CHANNEL__) == TIM_CHANNEL_2) ? ((__HANDLE__)->Instance->CCMR1 |= TIM_CCMR1_OC2PE) : \
+	 ((__CHANNEL__) == TIM_CHANNEL_3) ? ((__HANDLE__)->Instance->CCMR2 |= TIM_CCMR2_OC3PE) : \
+	 ((__HANDLE__)->Instance->CCMR2 |= TIM_CCMR2_OC4PE))
+
+/* Core ----------------------------------------------------------------------*/
+extern uint32_t ulHost_PRIMASK;
+
+static inline void __DMB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline uint32_t __get_PRIMASK(void)
+{
+	return ulHost_PRIMASK;
+}
+
+static inline void __set_PRIMASK(uint32_t _ulPriMask)
+{
+	ulHost_PRIMASK = _ulPriMask;
+}
+
+static inline void __disable_irq(void)
+{
+	ulHost_PRIMASK = 1;
+}
+
+static inline void __enable_irq(void)
+{
+	ulHost_PRIMASK = 0;
+}
+
+/* HAL functions -------------------------------------------------------------*/
+uint32_t HAL_RCC_GetHCLKFreq(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_OC_Init(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef* htim, TIM_ClockConfigTypeDef* sClockSourceConfig);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef* htim, TIM_OC_InitTypeDef* sConfig, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef* htim, TIM_OC_InitTypeDef* sConfig, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef* htim, TIM_MasterConfigTypeDef* sMasterConfig);
+HAL_StatusTypeDef HAL_TIMEx_ConfigBreakDeadTime(TIM_HandleTypeDef* htim, TIM_BreakDeadTimeConfigTypeDef* sBreakDeadTimeConfig);
+HAL_StatusTypeDef HAL_TIM_SlaveConfigSynchro(TIM_HandleTypeDef* htim, TIM_SlaveConfigTypeDef* sSlaveConfig);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Start(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Stop(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_DMABurst_MultiWriteStart(TIM_HandleTypeDef* htim, uint32_t BurstBaseAddress, uint32_t BurstRequestSrc,
+												   uint32_t* BurstBuffer, uint32_t BurstLength, uint32_t DataLength);
+HAL_StatusTypeDef HAL_TIM_DMABurst_WriteStop(TIM_HandleTypeDef* htim, uint32_t BurstRequestSrc);
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef* htim);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim);
+void HAL_TIM_PeriodElapsedHalfCpltCallback(TIM_HandleTypeDef* htim);
+void Error_Handler(void);
+
+/* Host model functions ------------------------------------------------------*/
+void Host_Reset(void);
+void Host_Set_Clocks(uint32_t _ulHCLK, uint32_t _ulPCLK1, uint32_t _ulPCLK2);
+void Host_Reset_Counters(void);
+void Host_Timer_Handle_Init(TIM_HandleTypeDef* _pxHandle, TIM_TypeDef* _pxInstance, DMA_HandleTypeDef* _pxDMA);
+bool Host_Timer_Overflow(TIM_TypeDef* _pxTimer);
+uint32_t Host_Active_ARR(TIM_TypeDef* _pxTimer);
+uint32_t Host_Active_PSC(TIM_TypeDef* _pxTimer);
+uint32_t Host_Active_CCR(TIM_TypeDef* _pxTimer, uint8_t _ucIndex);
+uint32_t Host_Active_RCR(TIM_TypeDef* _pxTimer);
+void Host_Break(TIM_TypeDef* _pxTimer);
+
+#endif /* HOST_MAIN_H */
+/*****END OF FILE*****/
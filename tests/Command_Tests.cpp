@@ -0,0 +1,101 @@
+/**
+  ******************************************************************************
+  * @file    Command_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of the command mailbox. The posted records are calculated by
+  *          the Post functions and copied by the update interrupt.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Posted_Dutycycle_Follows_Posted_Frequency)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Start_Command_Queue();
+	xPWM.Post_DutyCycle_Q16(TIM_CHANNEL_1, 0x4000);
+	CHECK(xPWM.Post_Frequency(25000));	//The dutycycle which is posted before is calculated by the new period
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(6799, TIM1->ARR);
+	CHECK_EQUAL(1700, TIM1->CCR1);
+	CHECK_EQUAL(3399, TIM1->CCR2);		//4249 of 8500 keeps its dutycycle
+	CHECK_EQUAL(25000, xTimer.xSpecs._ulFrequency);
+	CHECK_EQUAL(6799, xPWM.Get_Period());
+
+	CHECK(xPWM.Post_Frequency(20000));
+	xPWM.Post_DutyCycle(TIM_CHANNEL_2, 75);
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(8499, TIM1->ARR);
+	CHECK_EQUAL(2125, TIM1->CCR1);
+	CHECK_EQUAL(6375, TIM1->CCR2);
+	xPWM.Stop_Command_Queue();
+}
+
+TEST(Posted_Dutycycle_Changes_Only_Its_Channel)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Start_Command_Queue();
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_2, 100);
+	xPWM.Post_DutyCycle_Q16(TIM_CHANNEL_1, 0x8000);
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(4250, TIM1->CCR1);
+	CHECK_EQUAL(100, TIM1->CCR2);
+	Host_Reset_Counters();
+	xPWM.Update_Event_Handler();		//Nothing is posted
+	CHECK_EQUAL(0, xHost_Counters.ulWrites & ~3U);	//Only Begin_Update and End_Update
+	xPWM.Stop_Command_Queue();
+}
+
+TEST(Post_Frequency_Rejects_Invalid_Frequencies)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Start_Command_Queue();
+	CHECK(xPWM.Post_Frequency(0) == false);
+	CHECK(xPWM.Post_Frequency(17000000) == false);
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(8499, TIM1->ARR);
+	CHECK_EQUAL(20000, xTimer.xSpecs._ulFrequency);
+	CHECK_EQUAL(4249, TIM1->CCR1);
+	xPWM.Stop_Command_Queue();
+}
+
+TEST(Stop_Command_Queue_Releases_Update_Interrupt)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Start_Command_Queue();
+	CHECK_EQUAL(TIM_DIER_UIE, TIM1->DIER & TIM_DIER_UIE);
+	xPWM.Stop_Command_Queue();
+	CHECK_EQUAL(0, TIM1->DIER & TIM_DIER_UIE);
+
+	xPWM.Start_Command_Queue();
+	xPWM.Start_Dithering(1, true);		//The dithering keeps the interrupt
+	xPWM.Stop_Command_Queue();
+	CHECK_EQUAL(TIM_DIER_UIE, TIM1->DIER & TIM_DIER_UIE);
+	xPWM.Stop_Dithering();
+	CHECK_EQUAL(0, TIM1->DIER & TIM_DIER_UIE);
+
+	__HAL_TIM_ENABLE_IT(&xTimer.xHandle, TIM_IT_UPDATE);	//The interrupt of user is not disabled
+	xPWM.Start_Command_Queue();
+	xPWM.Stop_Command_Queue();
+	CHECK_EQUAL(TIM_DIER_UIE, TIM1->DIER & TIM_DIER_UIE);
+}
+/*****END OF FILE*****/
@@ -0,0 +1,271 @@
+/**
+  ******************************************************************************
+  * @file    Conformance_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Backend conformance tests. The same tests are built with
+  *          HARDWARE_PWM_BACKEND_HAL and HARDWARE_PWM_BACKEND_LL, so both
+  *          backends should leave the timer registers in the same state.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+#include <math.h>
+
+using namespace Hardware_PWM_Ver1;
+
+/* Constants -----------------------------------------------------------------*/
+static const uint32_t ulOutputs = 0x1555U;	//CCxE and CCxNE bits of channel 1 to 4
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Constructor_Configures_Stopped_Timer)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	CHECK_EQUAL(0, TIM1->CCER & ulOutputs);
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_CEN);
+	CHECK_EQUAL(0, TIM1->BDTR & TIM_BDTR_MOE);
+	CHECK_EQUAL(8500, (uint64_t)(TIM1->PSC + 1) * (TIM1->ARR + 1));
+	CHECK_EQUAL(TIM1->ARR, xPWM.Get_Period());
+	CHECK_EQUAL(TIM1->ARR, Host_Active_ARR(TIM1));
+	CHECK_EQUAL(TIM_OCMODE_PWM1 | TIM_CCMR1_OC1PE, TIM1->CCMR1 & (TIM_CCMR1_OC1M | TIM_CCMR1_OC1PE));
+	CHECK_EQUAL((TIM_OCMODE_PWM1 | TIM_CCMR1_OC1PE) << 8, TIM1->CCMR1 & (TIM_CCMR1_OC2M | TIM_CCMR1_OC2PE));
+	CHECK_EQUAL(20000, xPWM.Get_Actual_Frequency());
+}
+
+TEST(Start_PWM_Complementary_Channel)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_PWM(TIM_CHANNEL_1, 25);
+	CHECK_EQUAL(TIM_CCER_CC1E | TIM_CCER_CC1NE, TIM1->CCER & ulOutputs);
+	CHECK_EQUAL(TIM_BDTR_MOE, TIM1->BDTR & TIM_BDTR_MOE);
+	CHECK_EQUAL(TIM_CR1_CEN, TIM1->CR1 & TIM_CR1_CEN);
+	CHECK_EQUAL((uint32_t)(xPWM.Get_Period() * 0.25), TIM1->CCR1);
+}
+
+TEST(Start_PWM_Single_Channel)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_PWM(TIM_CHANNEL_3, 50);
+	CHECK_EQUAL(TIM_CCER_CC1E << TIM_CHANNEL_3, TIM1->CCER & ulOutputs);
+	CHECK_EQUAL((uint32_t)(xPWM.Get_Period() * 0.5), TIM1->CCR3);
+}
+
+TEST(Start_PWM_Disabled_Channel_Does_Nothing)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_PWM(TIM_CHANNEL_4, 50);
+	CHECK_EQUAL(0, TIM1->CCER & ulOutputs);
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_CEN);
+}
+
+TEST(Stop_PWM_Keeps_Other_Channels)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_PWM(TIM_CHANNEL_1, 25);
+	xPWM.Start_PWM(TIM_CHANNEL_2, 75);
+	xPWM.Stop_PWM(TIM_CHANNEL_1);
+	CHECK_EQUAL((TIM_CCER_CC1E | TIM_CCER_CC1NE) << TIM_CHANNEL_2, TIM1->CCER & ulOutputs);
+	CHECK_EQUAL(TIM_BDTR_MOE, TIM1->BDTR & TIM_BDTR_MOE);
+	CHECK_EQUAL(TIM_CR1_CEN, TIM1->CR1 & TIM_CR1_CEN);
+}
+
+TEST(Stop_PWM_Of_Last_Channel_Stops_Timer)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_PWM(TIM_CHANNEL_1, 25);
+	xPWM.Stop_PWM(TIM_CHANNEL_1);
+	CHECK_EQUAL(0, TIM1->CCER & ulOutputs);
+	CHECK_EQUAL(0, TIM1->BDTR & TIM_BDTR_MOE);
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_CEN);
+}
+
+TEST(Start_All_PWM_Enables_Used_Channels)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t Ticks = 0;
+
+	xPWM.Start_All_PWM(40);
+	Ticks = (uint32_t)(xPWM.Get_Period() * 0.4);
+	CHECK_EQUAL(TIM_CCER_CC1E | TIM_CCER_CC1NE | ((TIM_CCER_CC1E | TIM_CCER_CC1NE) << TIM_CHANNEL_2) | (TIM_CCER_CC1E << TIM_CHANNEL_3),
+				TIM1->CCER & ulOutputs);
+	CHECK_EQUAL(Ticks, TIM1->CCR1);
+	CHECK_EQUAL(Ticks, TIM1->CCR2);
+	CHECK_EQUAL(Ticks, TIM1->CCR3);
+	CHECK_EQUAL(TIM_BDTR_MOE, TIM1->BDTR & TIM_BDTR_MOE);
+	CHECK_EQUAL(TIM_CR1_CEN, TIM1->CR1 & TIM_CR1_CEN);
+}
+
+TEST(Stop_All_PWM_Disables_Outputs_And_Timer)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(40);
+	xPWM.Stop_All_PWM();
+	CHECK_EQUAL(0, TIM1->CCER & ulOutputs);
+	CHECK_EQUAL(0, TIM1->BDTR & TIM_BDTR_MOE);
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_CEN);
+
+	xPWM.Start_PWM(TIM_CHANNEL_2, 10);	//It can be started again
+	CHECK_EQUAL((TIM_CCER_CC1E | TIM_CCER_CC1NE) << TIM_CHANNEL_2, TIM1->CCER & ulOutputs);
+	CHECK_EQUAL(TIM_CR1_CEN, TIM1->CR1 & TIM_CR1_CEN);
+}
+
+TEST(Change_DutyCycle_Writes_Only_Compare)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t CCER = 0;
+
+	xPWM.Start_PWM(TIM_CHANNEL_2, 10);
+	CCER = TIM1->CCER;
+	xPWM.Change_DutyCycle(TIM_CHANNEL_2, 60);
+	CHECK_EQUAL((uint32_t)(xPWM.Get_Period() * 0.6), TIM1->CCR2);
+	CHECK_EQUAL(CCER, TIM1->CCER);
+	CHECK_EQUAL(TIM_CR1_CEN, TIM1->CR1 & TIM_CR1_CEN);
+}
+
+TEST(Change_Frequency_Loads_New_Period)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Change_Frequency(25000);
+	CHECK_EQUAL(6800, (uint64_t)(TIM1->PSC + 1) * (TIM1->ARR + 1));
+	CHECK_EQUAL(TIM1->ARR, xPWM.Get_Period());
+	CHECK_EQUAL(TIM1->ARR, Host_Active_ARR(TIM1));
+	CHECK_EQUAL(TIM1->PSC, Host_Active_PSC(TIM1));
+	CHECK_EQUAL(25000, xPWM.Get_Actual_Frequency());
+	CHECK_EQUAL(0, TIM1->CCER & ulOutputs);		//The channels should be started again
+
+	xPWM.Start_PWM(TIM_CHANNEL_1, 50);
+	CHECK_EQUAL((uint32_t)(xPWM.Get_Period() * 0.5), TIM1->CCR1);
+	CHECK_EQUAL(TIM_CCER_CC1E | TIM_CCER_CC1NE, TIM1->CCER & ulOutputs);
+}
+
+TEST(Change_Frequency_Uses_Prescaler_For_Low_Frequencies)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Change_Frequency(100);
+	CHECK(TIM1->PSC > 0);
+	CHECK(TIM1->ARR <= 0xFFFF);
+	CHECK(fabs(xPWM.Get_Actual_Frequency() - 100.0) < 0.01);
+	CHECK(fabs(xPWM.Get_Actual_Frequency() - (170000000.0 / ((uint64_t)(TIM1->PSC + 1) * (TIM1->ARR + 1)))) < 1e-9);
+	CHECK_EQUAL(TIM1->PSC, Host_Active_PSC(TIM1));
+}
+
+TEST(Slave_Timer_Is_Started_By_Master)
+{
+	Test_Timer xMaster_Timer(TIM1, 20000);
+	Test_Timer xSlave_Timer(TIM8, 20000);
+	Hardware_PWM xMaster(&xMaster_Timer.xHandle, &xMaster_Timer.xChannels, &xMaster_Timer.xSpecs);
+	Hardware_PWM xSlave(&xSlave_Timer.xHandle, &xSlave_Timer.xChannels, &xSlave_Timer.xSpecs);
+	Hardware_PWM_Group xGroup(&xMaster);
+
+	CHECK(xGroup.Add_Slave(&xSlave, TIM_TS_ITR0));
+	xSlave.Start_PWM(TIM_CHANNEL_1, 50);
+	CHECK_EQUAL(TIM_CCER_CC1E | TIM_CCER_CC1NE, TIM8->CCER & ulOutputs);
+	CHECK_EQUAL(0, TIM8->CR1 & TIM_CR1_CEN);	//The trigger of master sets the counter enable bit
+	CHECK_EQUAL(TIM_SLAVEMODE_TRIGGER, TIM8->SMCR & TIM_SMCR_SMS);
+}
+
+TEST(Unchanged_DutyCycle_Does_Not_Touch_The_Timer)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_PWM(TIM_CHANNEL_1, 25);
+	Host_Reset_Counters();
+	xPWM.Change_DutyCycle(TIM_CHANNEL_1, 25);
+	CHECK_EQUAL(0, xHost_Counters.ulReads);		//The compare value is checked by the software copy
+	CHECK_EQUAL(0, xHost_Counters.ulWrites);
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_1, 100);	//The fast path keeps the copy too
+	xPWM.Change_DutyCycle(TIM_CHANNEL_1, 25);
+	CHECK_EQUAL((uint32_t)(xPWM.Get_Period() * 0.25), TIM1->CCR1);
+}
+
+TEST(Change_Frequency_Recalculates_DeadTime_For_New_Clock)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	xTimer.xSpecs._ulDeadTime = 500;
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	CHECK_EQUAL(85, TIM1->BDTR & TIM_BDTR_DTG);		//500 nS at 170 MHz
+	Host_Set_Clocks(85000000, 85000000, 85000000);
+	xPWM.Invalidate_Timer_Clock();
+	CHECK(xPWM.Change_Frequency(20000));
+	CHECK_EQUAL(43, TIM1->BDTR & TIM_BDTR_DTG);		//500 nS at 85 MHz, rounded up
+	CHECK_EQUAL(TIM_CLOCKDIVISION_DIV1, TIM1->CR1 & TIM_CR1_CKD);
+	CHECK_EQUAL(505, xPWM.Get_DeadTime());
+}
+
+TEST(Change_Frequency_Recalculates_Clock_Division_For_New_Clock)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	xTimer.xSpecs._ulDeadTime = 10000;
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	CHECK_EQUAL(0xF6, TIM1->BDTR & TIM_BDTR_DTG);	//850 * 2 timer clocks at 170 MHz
+	CHECK_EQUAL(TIM_CLOCKDIVISION_DIV2, TIM1->CR1 & TIM_CR1_CKD);
+	Host_Set_Clocks(85000000, 85000000, 85000000);
+	xPWM.Invalidate_Timer_Clock();
+	CHECK(xPWM.Change_Frequency(20000));
+	CHECK_EQUAL(0xF6, TIM1->BDTR & TIM_BDTR_DTG);	//850 timer clocks at 85 MHz
+	CHECK_EQUAL(TIM_CLOCKDIVISION_DIV1, TIM1->CR1 & TIM_CR1_CKD);
+	CHECK_EQUAL(TIM_CLOCKDIVISION_DIV1, xTimer.xHandle.Init.ClockDivision);
+}
+
+TEST(Latched_Break_Keeps_Main_Output_Disabled)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	Host_Break(TIM1);
+	xPWM.Stop_PWM(TIM_CHANNEL_1);
+	xPWM.Start_PWM(TIM_CHANNEL_1, 50);
+	xPWM.Start_PWM(TIM_CHANNEL_2, 50);
+	CHECK_EQUAL(0, TIM1->BDTR & TIM_BDTR_MOE);
+	CHECK_EQUAL(TIM_CCER_CC1E | TIM_CCER_CC1NE, TIM1->CCER & (TIM_CCER_CC1E | TIM_CCER_CC1NE));
+	CHECK(xPWM.Break_Recover());
+	CHECK_EQUAL(TIM_BDTR_MOE, TIM1->BDTR & TIM_BDTR_MOE);
+}
+
+TEST(Backend_Hot_Paths_Call_Count)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	Host_Reset_Counters();
+	xPWM.Start_PWM(TIM_CHANNEL_1, 25);
+	xPWM.Change_DutyCycle(TIM_CHANNEL_1, 30);
+	xPWM.Stop_PWM(TIM_CHANNEL_1);
+	xPWM.Start_All_PWM(50);
+	xPWM.Stop_All_PWM();
+#if (HARDWARE_PWM_BACKEND == HARDWARE_PWM_BACKEND_LL)
+	CHECK_EQUAL(0, xHost_Counters.ulHAL_Calls);
+#else
+	CHECK(xHost_Counters.ulHAL_Calls > 0);
+#endif
+	CHECK_EQUAL(0, xHost_Counters.ulErrors);
+}
+/*****END OF FILE*****/
@@ -0,0 +1,139 @@
+/**
+  ******************************************************************************
+  * @file    DeadTime_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of the deadtime register (DTG) and clock division (CKD)
+  *          against the deadtime formula of the reference manual.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+#include <inttypes.h>
+#include <stdio.h>
+
+using namespace Hardware_PWM_Ver1;
+
+/* Functions -----------------------------------------------------------------*/
+/**
+  * @brief  This function decodes a DTG value by the reference manual
+  * @param  _ucDTG: The deadtime register value
+  * @retval Deadtime according to tDTS
+  */
+static uint32_t DTG_Decode(uint8_t _ucDTG)
+{
+	if ((_ucDTG & 0x80) == 0)
+	{
+		return _ucDTG;
+	}
+	else if ((_ucDTG & 0xC0) == 0x80)
+	{
+		return (64 + (_ucDTG & 0x3F)) * 2;
+	}
+	else if ((_ucDTG & 0xE0) == 0xC0)
+	{
+		return (32 + (_ucDTG & 0x1F)) * 8;
+	}
+	return (32 + (_ucDTG & 0x1F)) * 16;
+}
+
+/**
+  * @brief  This function returns the DTG range of a DTG value
+  * @param  _ucDTG: The deadtime register value
+  * @retval 0 to 3
+  */
+static uint8_t DTG_Range(uint8_t _ucDTG)
+{
+	return ((_ucDTG & 0x80) == 0) ? 0 : ((_ucDTG & 0xC0) == 0x80) ? 1 : ((_ucDTG & 0xE0) == 0xC0) ? 2 : 3;
+}
+
+/**
+  * @brief  This function checks every deadtime from 0 to a little more than the maximum deadtime of a timer clock.
+  *			The clock division should be the smallest one which has the deadtime, and the DTG should be the shortest
+  *			deadtime of all 256 values which is not shorter than the requested deadtime.
+  * @param  _ulTimer_Clock: The timer clock according to Hz
+  *			_pxRanges: Saves the used DTG ranges of each clock division
+  * @retval None
+  */
+static void DeadTime_Sweep(uint32_t _ulTimer_Clock, bool (*_pxRanges)[4])
+{
+	uint32_t Maximum = (uint32_t)((1008ULL * 4 * 1000000000ULL) / _ulTimer_Clock) + 100;
+	uint32_t Failures = 0;
+
+	Host_Reset();
+	Host_Set_Clocks(_ulTimer_Clock, _ulTimer_Clock, _ulTimer_Clock);
+	for (uint32_t Time = 0; Time <= Maximum; Time++)
+	{
+		Test_Timer xTimer(TIM1, 20000);
+		xTimer.xSpecs._ulDeadTime = Time;
+		Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+		uint64_t Clocks = (((uint64_t)_ulTimer_Clock * Time) + 999999999ULL) / 1000000000ULL;	//Requested deadtime according to timer clocks
+		uint32_t Division = (Clocks <= 1008) ? 1 : (Clocks <= 2016) ? 2 : 4;
+		uint32_t Division_Bits = (Division == 1) ? TIM_CLOCKDIVISION_DIV1 : (Division == 2) ? TIM_CLOCKDIVISION_DIV2 : TIM_CLOCKDIVISION_DIV4;
+		uint64_t Request = (Clocks + Division - 1) / Division;	//Requested deadtime according to tDTS
+		uint32_t Expected = 1008;
+		uint8_t DTG = (uint8_t)(TIM1->BDTR & TIM_BDTR_DTG);
+
+		for (uint32_t Value = 0; Value <= 0xFF; Value++)	//The shortest deadtime which is not shorter than the request
+		{
+			if ((DTG_Decode((uint8_t)Value) >= Request) && (DTG_Decode((uint8_t)Value) < Expected))
+			{
+				Expected = DTG_Decode((uint8_t)Value);
+			}
+		}
+		if (((TIM1->CR1 & TIM_CR1_CKD) != Division_Bits) || (DTG_Decode(DTG) != Expected) ||
+			(xPWM.Get_DeadTime() != (uint32_t)(((uint64_t)Expected * Division * 1000000000ULL) / _ulTimer_Clock)))
+		{
+			if (Failures++ < 4)	//Report only the first values
+			{
+				printf("  Deadtime %" PRIu32 " nS at %" PRIu32 " Hz:\n", Time, _ulTimer_Clock);
+				CHECK_EQUAL(Division_Bits, TIM1->CR1 & TIM_CR1_CKD);
+				CHECK_EQUAL(Expected, DTG_Decode(DTG));
+			}
+		}
+		_pxRanges[Division >> 1][DTG_Range(DTG)] = true;
+	}
+	CHECK_EQUAL(0, Failures);
+}
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(DeadTime_Matches_Reference_Manual_At_170MHz)
+{
+	bool Ranges[3][4] = {{false}};
+
+	DeadTime_Sweep(170000000, Ranges);
+	for (uint8_t i = 0; i < 4; i++)	//All DTG ranges without clock division
+	{
+		CHECK(Ranges[0][i]);
+	}
+	CHECK(Ranges[1][3]);	//The clock division is used only when the last range of DTG is not enough
+	CHECK(Ranges[2][3]);
+}
+
+TEST(DeadTime_Matches_Reference_Manual_At_16MHz)
+{
+	bool Ranges[3][4] = {{false}};
+
+	DeadTime_Sweep(16000000, Ranges);
+	for (uint8_t i = 0; i < 4; i++)
+	{
+		CHECK(Ranges[0][i]);
+	}
+	CHECK(Ranges[1][3]);
+	CHECK(Ranges[2][3]);
+}
+
+TEST(DeadTime_Is_Limited_To_Longest_Value)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	xTimer.xSpecs._ulDeadTime = 1000000;	//1 mS is longer than 1008 * 4 timer clocks
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	CHECK_EQUAL(0xFF, TIM1->BDTR & TIM_BDTR_DTG);
+	CHECK_EQUAL(TIM_CLOCKDIVISION_DIV4, TIM1->CR1 & TIM_CR1_CKD);
+	CHECK_EQUAL((1008ULL * 4 * 1000000000ULL) / 170000000, xPWM.Get_DeadTime());
+}
+/*****END OF FILE*****/
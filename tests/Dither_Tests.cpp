@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file    Dither_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of high resolution dutycycles by sigma-delta dithering.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Dithering_Averages_Fractional_Ticks)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t Sum = 0;
+
+	xPWM.Start_All_PWM(50);
+	for (uint8_t Order = 1; Order <= 2; Order++)
+	{
+		Sum = 0;
+		xPWM.Start_Dithering(Order, true);
+		xPWM.Set_DutyCycle_HighRes_Q8(TIM_CHANNEL_1, (1000 * 256) + 64);	//1000.25 ticks
+		for (uint32_t n = 0; n < 256; n++)
+		{
+			xPWM.Update_Event_Handler();
+			Sum += TIM1->CCR1;
+		}
+		CHECK_EQUAL((1000 * 256) + 64, Sum);
+		xPWM.Stop_Dithering();
+	}
+}
+
+TEST(Dithering_Does_Not_Wind_Up_When_Clamped)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Start_Dithering(2, true);
+	xPWM.Set_DutyCycle_HighRes_Q8(TIM_CHANNEL_1, (8500 + 100) * 256);	//Above 100%
+	for (uint32_t n = 0; n < 100; n++)
+	{
+		xPWM.Update_Event_Handler();
+		CHECK_EQUAL(8500, TIM1->CCR1);
+	}
+	xPWM.Set_DutyCycle_HighRes_Q8(TIM_CHANNEL_1, (1000 * 256) + 128);
+	for (uint32_t n = 0; n < 8; n++)
+	{
+		xPWM.Update_Event_Handler();
+		CHECK((TIM1->CCR1 >= 999) && (TIM1->CCR1 <= 1002));	//It follows the new target at once
+	}
+}
+
+TEST(Stop_Dithering_Releases_Update_Interrupt)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Start_Dithering(1, true);
+	CHECK_EQUAL(TIM_DIER_UIE, TIM1->DIER & TIM_DIER_UIE);
+	xPWM.Stop_Dithering();
+	CHECK_EQUAL(0, TIM1->DIER & TIM_DIER_UIE);
+
+	xPWM.Start_Dithering(1, true);
+	xPWM.Start_Command_Queue();
+	xPWM.Stop_Dithering();
+	CHECK_EQUAL(TIM_DIER_UIE, TIM1->DIER & TIM_DIER_UIE);	//The command queue uses it
+	xPWM.Stop_Command_Queue();
+}
+/*****END OF FILE*****/
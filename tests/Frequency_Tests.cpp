@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file    Frequency_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of frequency changes which keep the dutycycles and of the
+  *          frequency checks before the registers are written.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Seamless_Frequency_Changes_Do_Not_Drift)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	static const uint32_t ulFrequencies[3] = {21001, 17777, 23456};
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_1, 1235);
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_2, 7);
+	for (uint32_t n = 0; n < 300; n++)
+	{
+		CHECK(xPWM.Change_Frequency_Seamless(ulFrequencies[n % 3]));
+	}
+	CHECK(xPWM.Change_Frequency_Seamless(20000));
+	CHECK_EQUAL(8499, TIM1->ARR);
+	CHECK_EQUAL(1235, TIM1->CCR1);
+	CHECK_EQUAL(7, TIM1->CCR2);
+}
+
+TEST(Seamless_Frequency_Change_Rounds_Compare_Values)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_1, 1001);
+	CHECK(xPWM.Change_Frequency_Seamless(25000));
+	CHECK_EQUAL(801, TIM1->CCR1);		//1001 * 6800 / 8500 = 800.8
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_1, 3000);	//A new dutycycle is taken from the register
+	CHECK(xPWM.Change_Frequency_Seamless(20000));
+	CHECK_EQUAL(3750, TIM1->CCR1);
+}
+
+TEST(Invalid_Frequencies_Change_Nothing)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t CCER = 0;
+
+	xPWM.Start_All_PWM(50);
+	CCER = TIM1->CCER;
+	Host_Reset_Counters();
+	CHECK(xPWM.Change_Frequency_Seamless(0) == false);
+	CHECK(xPWM.Change_Frequency_Seamless(17000000) == false);	//1/10 of the timer clock
+	CHECK(xPWM.Change_Frequency(0) == false);
+	CHECK_EQUAL(0, xHost_Counters.ulWrites);
+	CHECK_EQUAL(20000, xTimer.xSpecs._ulFrequency);
+	CHECK_EQUAL(8499, xPWM.Get_Period());
+	CHECK_EQUAL(CCER, TIM1->CCER);		//The outputs are not stopped
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_UDIS);
+
+	CHECK(xPWM.Change_Frequency_Seamless(16999999) == true);
+}
+/*****END OF FILE*****/
@@ -0,0 +1,96 @@
+/**
+  ******************************************************************************
+  * @file    Group_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of synchronized timer groups with equal and different timer
+  *          clocks.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Group_Change_Frequency_Keeps_Equal_Periods)
+{
+	Test_Timer xMaster_Timer(TIM1, 20000);
+	Test_Timer xSlave_Timer(TIM8, 20000);
+	Hardware_PWM xMaster(&xMaster_Timer.xHandle, &xMaster_Timer.xChannels, &xMaster_Timer.xSpecs);
+	Hardware_PWM xSlave(&xSlave_Timer.xHandle, &xSlave_Timer.xChannels, &xSlave_Timer.xSpecs);
+	Hardware_PWM_Group xGroup(&xMaster);
+
+	CHECK(xGroup.Add_Slave(&xSlave, TIM_TS_ITR0));
+	xGroup.Start_All_PWM(50);
+	CHECK(xGroup.Change_Frequency(333));
+	CHECK_EQUAL(TIM1->PSC, TIM8->PSC);
+	CHECK_EQUAL(TIM1->ARR, TIM8->ARR);
+	CHECK_EQUAL(333, xSlave_Timer.xSpecs._ulFrequency);
+	CHECK(xGroup.Change_Frequency(0) == false);
+	CHECK_EQUAL(333, xMaster_Timer.xSpecs._ulFrequency);
+}
+
+TEST(Group_Derives_Slave_Prescaler_From_Master)
+{
+	Host_Set_Clocks(170000000, 42500000, 170000000);	//The APB1 timers have 85 MHz
+	Test_Timer xMaster_Timer(TIM1, 100);
+	Test_Timer xSlave_Timer(TIM3, 101);
+	Hardware_PWM xMaster(&xMaster_Timer.xHandle, &xMaster_Timer.xChannels, &xMaster_Timer.xSpecs);
+	Hardware_PWM xSlave(&xSlave_Timer.xHandle, &xSlave_Timer.xChannels, &xSlave_Timer.xSpecs);
+	Hardware_PWM_Group xGroup(&xMaster);
+
+	CHECK_EQUAL(25, TIM1->PSC);
+	CHECK_EQUAL(65384, TIM1->ARR);
+	CHECK(xGroup.Add_Slave(&xSlave, TIM_TS_ITR0));
+	CHECK_EQUAL(12, TIM3->PSC);		//The slave has the period of master, not its own frequency
+	CHECK_EQUAL(65384, TIM3->ARR);
+	CHECK_EQUAL(100, xSlave_Timer.xSpecs._ulFrequency);
+
+	CHECK(xGroup.Change_Frequency(50));
+	CHECK_EQUAL((uint64_t)(TIM1->PSC + 1) * 85000000, (uint64_t)(TIM3->PSC + 1) * 170000000);
+	CHECK_EQUAL(TIM1->ARR, TIM3->ARR);
+
+	Host_Reset_Counters();
+	CHECK(xGroup.Change_Frequency(20000) == false);	//The slave would need half of a prescaler step
+	CHECK_EQUAL(0, xHost_Counters.ulWrites);
+	CHECK_EQUAL(50, xMaster_Timer.xSpecs._ulFrequency);
+}
+
+TEST(Group_Rejects_Slave_Which_Can_Not_Follow_Master)
+{
+	Host_Set_Clocks(170000000, 42500000, 170000000);
+	Test_Timer xMaster_Timer(TIM1, 20000);
+	Test_Timer xSlave_Timer(TIM3, 20000);
+	Hardware_PWM xMaster(&xMaster_Timer.xHandle, &xMaster_Timer.xChannels, &xMaster_Timer.xSpecs);
+	Hardware_PWM xSlave(&xSlave_Timer.xHandle, &xSlave_Timer.xChannels, &xSlave_Timer.xSpecs);
+	Hardware_PWM_Group xGroup(&xMaster);
+
+	CHECK(xGroup.Add_Slave(&xSlave, TIM_TS_ITR0) == false);
+	CHECK_EQUAL(0, TIM3->SMCR & TIM_SMCR_SMS);
+}
+
+TEST(Group_Start_Applies_Phase_Offset)
+{
+	Test_Timer xMaster_Timer(TIM1, 20000);
+	Test_Timer xSlave_Timer(TIM8, 20000);
+	Test_Timer xThird_Timer(TIM3, 20000);
+	Hardware_PWM xMaster(&xMaster_Timer.xHandle, &xMaster_Timer.xChannels, &xMaster_Timer.xSpecs);
+	Hardware_PWM xSlave(&xSlave_Timer.xHandle, &xSlave_Timer.xChannels, &xSlave_Timer.xSpecs);
+	Hardware_PWM xThird(&xThird_Timer.xHandle, &xThird_Timer.xChannels, &xThird_Timer.xSpecs);
+	Hardware_PWM_Group xGroup(&xMaster);
+
+	CHECK(xGroup.Add_Slave(&xSlave, TIM_TS_ITR0));
+	CHECK(xGroup.Add_Slave(&xThird, TIM_TS_ITR0));
+	xGroup.Set_Phase_Ticks(1, 2000);
+	xGroup.Set_Phase_Degrees(2, 270);
+	TIM1->CNT = 1234;
+	xGroup.Start_All_PWM(50);
+	CHECK_EQUAL(0, TIM1->CNT);
+	CHECK_EQUAL(8500 - 2000, TIM8->CNT);	//The slave is 2000 ticks behind the master
+	CHECK_EQUAL(8500 - 6375, TIM3->CNT);
+}
+/*****END OF FILE*****/
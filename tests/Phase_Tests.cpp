@@ -0,0 +1,136 @@
+/**
+  ******************************************************************************
+  * @file    Phase_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of phase shifted channels (combined PWM mode) and of phase
+  *          shifted timers in a group.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Phase_Needs_A_Free_Partner_Channel)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t CCMR1 = 0;
+
+	xPWM.Start_All_PWM(50);
+	CCMR1 = TIM1->CCMR1;
+	CHECK(xPWM.Set_Phase_Ticks(TIM_CHANNEL_1, 1000, 2000) == false);	//Channel 2 is an output
+	CHECK(xPWM.Set_Phase_Ticks(TIM_CHANNEL_2, 1000, 2000) == false);
+	CHECK(xPWM.Set_Phase_Degrees(TIM_CHANNEL_4, 90, 50) == false);
+	CHECK_EQUAL(0, TIM1->DIER & TIM_DIER_UIE);
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(CCMR1, TIM1->CCMR1);
+
+	CHECK(xPWM.Set_Phase_Ticks(TIM_CHANNEL_3, 1000, 2000));	//Channel 4 is Disable
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(1000, TIM1->CCR3);
+	CHECK_EQUAL(3000, TIM1->CCR4);
+}
+
+TEST(Phase_Uses_Counts_Of_Center_Aligned_Mode)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	xTimer.xSpecs._ulCounterMode = TIM_COUNTERMODE_CENTERALIGNED1;
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	CHECK_EQUAL(4250, xPWM.Get_Period());
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Set_Phase_Ticks(TIM_CHANNEL_3, 4250, 100));	//One full period is phase 0
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(0, TIM1->CCR3);
+	CHECK_EQUAL(100, TIM1->CCR4);
+}
+
+TEST(Group_Phase_Stretches_Whole_Periods)
+{
+	Test_Timer xMaster_Timer(TIM1, 20000);
+	Test_Timer xSlave_Timer(TIM8, 20000);
+	Hardware_PWM xMaster(&xMaster_Timer.xHandle, &xMaster_Timer.xChannels, &xMaster_Timer.xSpecs);
+	Hardware_PWM xSlave(&xSlave_Timer.xHandle, &xSlave_Timer.xChannels, &xSlave_Timer.xSpecs);
+	Hardware_PWM_Group xGroup(&xMaster);
+
+	CHECK(xGroup.Add_Slave(&xSlave, TIM_TS_ITR0));
+	TIM1->CR1 &= ~TIM_CR1_ARPE;		//Like Timer_Init
+	TIM8->CR1 &= ~TIM_CR1_ARPE;
+	xGroup.Start_All_PWM(50);
+	TIM8->CR1 |= TIM_CR1_CEN;		//The trigger of master is not modeled
+	xGroup.Set_Phase_Degrees(1, 90);
+	CHECK_EQUAL(TIM_CR1_ARPE, TIM8->CR1 & TIM_CR1_ARPE);
+	CHECK_EQUAL(TIM_DIER_UIE, TIM8->DIER & TIM_DIER_UIE);
+	CHECK_EQUAL(0, ulHost_PRIMASK);
+
+	xSlave.Update_Event_Handler();
+	CHECK_EQUAL(8499 + 2125, TIM8->ARR);
+	CHECK_EQUAL(8499, Host_Active_ARR(TIM8));	//The running period is not cut
+	CHECK(Host_Timer_Overflow(TIM8));
+	CHECK_EQUAL(8499 + 2125, Host_Active_ARR(TIM8));
+	xSlave.Update_Event_Handler();
+	CHECK_EQUAL(8499, TIM8->ARR);
+}
+
+TEST(Phase_Degrees_Scale_Duty_By_Counts)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Set_Phase_Degrees(TIM_CHANNEL_3, 90, 50));
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(2125, TIM1->CCR3);
+	CHECK_EQUAL(2125 + 4250, TIM1->CCR4);	//Half of 8500 counts
+}
+
+TEST(Phase_Releases_Update_Interrupt)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Set_Phase_Ticks(TIM_CHANNEL_3, 1000, 2000));
+	CHECK_EQUAL(TIM_DIER_UIE, TIM1->DIER & TIM_DIER_UIE);
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(0, TIM1->DIER & TIM_DIER_UIE);
+
+	xPWM.Start_Dithering(1, true);		//The dithering keeps the interrupt
+	CHECK(xPWM.Set_Phase_Ticks(TIM_CHANNEL_3, 2000, 2000));
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(TIM_DIER_UIE, TIM1->DIER & TIM_DIER_UIE);
+	xPWM.Stop_Dithering();
+	CHECK_EQUAL(0, TIM1->DIER & TIM_DIER_UIE);
+
+	__HAL_TIM_ENABLE_IT(&xTimer.xHandle, TIM_IT_UPDATE);	//The interrupt of user is not disabled
+	CHECK(xPWM.Set_Phase_Ticks(TIM_CHANNEL_3, 3000, 2000));
+	xPWM.Update_Event_Handler();
+	CHECK_EQUAL(TIM_DIER_UIE, TIM1->DIER & TIM_DIER_UIE);
+}
+
+TEST(Group_Phase_Releases_Update_Interrupt_After_Restore)
+{
+	Test_Timer xMaster_Timer(TIM1, 20000);
+	Test_Timer xSlave_Timer(TIM8, 20000);
+	Hardware_PWM xMaster(&xMaster_Timer.xHandle, &xMaster_Timer.xChannels, &xMaster_Timer.xSpecs);
+	Hardware_PWM xSlave(&xSlave_Timer.xHandle, &xSlave_Timer.xChannels, &xSlave_Timer.xSpecs);
+	Hardware_PWM_Group xGroup(&xMaster);
+
+	CHECK(xGroup.Add_Slave(&xSlave, TIM_TS_ITR0));
+	xGroup.Start_All_PWM(50);
+	TIM8->CR1 |= TIM_CR1_CEN;
+	xGroup.Set_Phase_Degrees(1, 90);
+	xSlave.Update_Event_Handler();		//The longer period is loaded
+	CHECK_EQUAL(TIM_DIER_UIE, TIM8->DIER & TIM_DIER_UIE);
+	CHECK(Host_Timer_Overflow(TIM8));
+	xSlave.Update_Event_Handler();		//The period is restored
+	CHECK_EQUAL(8499, TIM8->ARR);
+	CHECK_EQUAL(0, TIM8->DIER & TIM_DIER_UIE);
+}
+/*****END OF FILE*****/
@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file    Pulse_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of pulse trains which are counted by the repetition counter
+  *          and stopped by the one pulse mode.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Pulse_Parts_Fit_In_8bit_Repetition_Counter)
+{
+	Test_Timer xTimer(TIM16, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Start_Pulse_Train(TIM_CHANNEL_1, 1000, 50));
+	CHECK_EQUAL(255, Host_Active_RCR(TIM16));	//The first part is loaded by the update generation
+	CHECK(TIM16->RCR <= 255);
+	xPWM.Stop_Pulse_Train();
+}
+
+TEST(Full_Dutycycle_Pulse_Is_Inactive_After_Train)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Start_Pulse_Train(TIM_CHANNEL_1, 10, 100));
+	CHECK_EQUAL(1, TIM1->CCR1);		//PWM mode 2 is inactive at the counter value 0
+	xPWM.Stop_Pulse_Train();
+}
+
+TEST(Pulse_Train_Needs_A_Free_Update_Event)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Start_Command_Queue();
+	CHECK(xPWM.Start_Pulse_Train(TIM_CHANNEL_1, 10, 50) == false);
+	xPWM.Stop_Command_Queue();
+	xPWM.Start_Dithering(1, true);
+	xPWM.Set_DutyCycle_HighRes_Q8(TIM_CHANNEL_2, 1000);
+	CHECK(xPWM.Start_Pulse_Train(TIM_CHANNEL_1, 10, 50) == false);
+	xPWM.Stop_Dithering();
+
+	CHECK(xPWM.Start_Pulse_Train(TIM_CHANNEL_1, 10, 50));
+	xPWM.Start_Command_Queue();
+	xPWM.Post_DutyCycle(TIM_CHANNEL_1, 10);
+	xPWM.Update_Event_Handler();	//The pulse train owns the timer
+	CHECK_EQUAL(8500 - 4250, TIM1->CCR1);
+	xPWM.Stop_Pulse_Train();
+	xPWM.Stop_Command_Queue();
+}
+/*****END OF FILE*****/
@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file    Ramp_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of ramp tables which are played by the update DMA request and
+  *          held by the repetition counter.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Variables -----------------------------------------------------------------*/
+static uint32_t ulRamp_Frames[128 * 6];
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Ramp_Build_Rejects_Too_Small_Tables)
+{
+	Test_Timer xTimer(TIM16, 20000, DMA_NORMAL);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	CHECK_EQUAL(0, xPWM.Ramp_Build_DutyCycle(ulRamp_Frames, 64, TIM_CHANNEL_1, 80, 1000, LinearRamp));	//20000 periods need 79 holds of 8 bit
+	CHECK_EQUAL(0, xPWM.Ramp_Build_DutyCycle(ulRamp_Frames, 1, TIM_CHANNEL_1, 80, 1, LinearRamp));
+	CHECK_EQUAL(100, xPWM.Ramp_Build_DutyCycle(ulRamp_Frames, 100, TIM_CHANNEL_1, 80, 1000, LinearRamp));
+}
+
+TEST(Ramp_Keeps_Its_Time_And_Last_Hold)
+{
+	Test_Timer xTimer(TIM16, 20000, DMA_NORMAL);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint16_t Frames = 0;
+	uint32_t Periods = 0;
+
+	xPWM.Start_All_PWM(50);
+	Frames = xPWM.Ramp_Build_DutyCycle(ulRamp_Frames, 100, TIM_CHANNEL_1, 80, 1000, LinearRamp);
+	CHECK_EQUAL(100, Frames);
+	for (uint16_t n = 0; n < (Frames - 1); n++)
+	{
+		CHECK(ulRamp_Frames[(n * 6) + 1] <= 255);
+		Periods += ulRamp_Frames[(n * 6) + 1] + 1;
+	}
+	CHECK_EQUAL(20000, Periods);
+	CHECK_EQUAL(0, ulRamp_Frames[((Frames - 1) * 6) + 1]);	//The terminal frame has the repetition counter of timer
+	CHECK_EQUAL(6800, ulRamp_Frames[((Frames - 1) * 6) + 2]);
+
+	CHECK(xPWM.Start_Ramp(ulRamp_Frames, Frames));
+	for (uint32_t n = 0; (n < 30000) && xPWM.Ramp_Is_Running(); n++)
+	{
+		Host_Timer_Overflow(TIM16);
+	}
+	CHECK(xPWM.Ramp_Is_Running() == false);
+	CHECK_EQUAL(ulRamp_Frames[((Frames - 2) * 6) + 1], Host_Active_RCR(TIM16));	//The last step is held to its end
+	CHECK_EQUAL(0, TIM16->RCR);
+	CHECK_EQUAL(6800, TIM16->CCR1);
+}
+/*****END OF FILE*****/
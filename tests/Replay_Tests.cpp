@@ -0,0 +1,128 @@
+/**
+  ******************************************************************************
+  * @file    Replay_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of the command replay. A recorded command log is replayed
+  *          and the output edges are compared with the recorded edges.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+#include "Hardware_PWM_Replay.hpp"
+#include <stdio.h>
+
+/* Variables -----------------------------------------------------------------*/
+static const char pcCommand_Log[] =
+	"# Complementary channel 1 with 500 nS deadtime and single channel 3\n"
+	"init 20000 500 C D S D\n"
+	"start 1 50\n"
+	"start 3 25\n"
+	"run 2\n"
+	"duty 1 10\n"
+	"duty 3 100\n"
+	"run 2\n"
+	"stop 1\n"
+	"run 1\n";
+
+static const char pcRecorded_Edges[] =
+	"# clock 170000000 Hz, time according to timer clocks\n"
+	"0 CH3 1\n"
+	"85 CH1 1\n"			//The deadtime is 85 timer clocks
+	"2124 CH3 0\n"
+	"4249 CH1 0\n"			//CCR1 = 4249
+	"4334 CH1N 1\n"
+	"8500 CH1N 0\n"
+	"8500 CH3 1\n"
+	"8585 CH1 1\n"
+	"10624 CH3 0\n"
+	"12749 CH1 0\n"
+	"12834 CH1N 1\n"
+	"17000 CH1N 0\n"		//The new dutycycles are loaded in the update event
+	"17000 CH3 1\n"
+	"17085 CH1 1\n"
+	"17849 CH1 0\n"			//CCR1 = 849
+	"17934 CH1N 1\n"
+	"25499 CH3 0\n"			//CCR3 = ARR, so the output is inactive for one tick
+	"25500 CH1N 0\n"
+	"25500 CH3 1\n"
+	"25585 CH1 1\n"
+	"26349 CH1 0\n"
+	"26434 CH1N 1\n"
+	"33999 CH3 0\n"
+	"34000 CH1N 0\n"		//Channel 1 is stopped
+	"34000 CH3 1\n"
+	"42499 CH3 0\n";
+
+/* Functions -----------------------------------------------------------------*/
+/**
+  * @brief  This function replays a command log from a string and reads the output
+  * @param  _pcLog: The command log
+  *			_xFormat: The format of output
+  *			_pcOutput: Saves the output
+  *			_ulSize: The size of _pcOutput
+  *			_pxSummary: Saves the summary
+  * @retval The return value of Replay_Run
+  */
+static bool Replay_String(const char* _pcLog, Replay_FormatType _xFormat, char* _pcOutput, size_t _ulSize, Replay_Summary_Type* _pxSummary)
+{
+	FILE* Input = tmpfile();
+	FILE* Output = tmpfile();
+	size_t Length = 0;
+	bool Applied = false;
+
+	fputs(_pcLog, Input);
+	rewind(Input);
+	Applied = Replay_Run(Input, Output, _xFormat, _pxSummary);
+	rewind(Output);
+	Length = fread(_pcOutput, 1, _ulSize - 1, Output);
+	_pcOutput[Length] = '\0';
+	fclose(Input);
+	fclose(Output);
+	return Applied;
+}
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Replay_Matches_Recorded_Edges)
+{
+	static char Output[4096];
+	Replay_Summary_Type Summary;
+
+	CHECK(Replay_String(pcCommand_Log, Replay_EdgeList, Output, sizeof(Output), &Summary));
+	CHECK(strcmp(Output, pcRecorded_Edges) == 0);
+	CHECK_EQUAL(5, Summary.ulPeriods);
+	CHECK_EQUAL(5 * 8500, Summary.ulTime);
+	CHECK_EQUAL(26, Summary.ulEdges);
+	CHECK_EQUAL(0, Summary.ulOverlaps);
+	CHECK_EQUAL(85, Summary.ulMin_Gap);
+}
+
+TEST(Replay_VCD_Has_Same_Edges)
+{
+	static char Output[8192];
+	Replay_Summary_Type Summary;
+
+	CHECK(Replay_String(pcCommand_Log, Replay_VCD, Output, sizeof(Output), &Summary));
+	CHECK_EQUAL(26, Summary.ulEdges);
+	CHECK(strstr(Output, "$var wire 1 b CH1N $end\n") != NULL);
+	CHECK(strstr(Output, "$var wire 1 c") == NULL);	//Channel 2 is disabled
+	CHECK(strstr(Output, "#500000\n1a\n") != NULL);		//85 timer clocks at 170 MHz
+	CHECK(strstr(Output, "#200000000\n0b\n1e\n") != NULL);	//Period 4 starts at 200 uS
+}
+
+TEST(Replay_Counts_Rejected_Lines)
+{
+	static char Output[4096];
+	Replay_Summary_Type Summary;
+
+	CHECK(Replay_String("run 1\ninit 20000 0 S D D D\nstart 5 50\nfrequency 0\nunknown\nstart 1 50\nrun 1\n",
+						Replay_None, Output, sizeof(Output), &Summary) == false);
+	CHECK_EQUAL(4, Summary.ulLine_Errors);	//run before init, channel 5, frequency 0 and unknown command
+	CHECK_EQUAL(1, Summary.ulPeriods);
+	CHECK_EQUAL(2, Summary.ulEdges);
+	CHECK_EQUAL(0, Output[0]);
+}
+/*****END OF FILE*****/
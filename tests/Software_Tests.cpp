@@ -0,0 +1,84 @@
+/**
+  ******************************************************************************
+  * @file    Software_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of software PWM channels which share the timer of a
+  *          Hardware_PWM object.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Constants -----------------------------------------------------------------*/
+static const Software_Pin_Type xPins[2] = {{GPIOA, GPIO_PIN_0}, {GPIOA, GPIO_PIN_1}};
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Attached_Software_PWM_Keeps_Counter_And_Compare_Channel)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	Software_PWM xSoftware(&xPWM, TIM_CHANNEL_4, xPins, 2);
+
+	xPWM.Start_All_PWM(50);
+	xSoftware.Start_All_PWM(25);
+	TIM1->CNT = 0;
+	xSoftware.Compare_Event_Handler();
+	CHECK_EQUAL(2125, TIM1->CCR4);
+	xPWM.Stop_All_PWM();
+	CHECK_EQUAL(TIM_CR1_CEN, TIM1->CR1 & TIM_CR1_CEN);	//The software channels are running
+
+	CHECK(xPWM.Change_Frequency(25000));
+	CHECK_EQUAL(TIM_CR1_CEN, TIM1->CR1 & TIM_CR1_CEN);
+	CHECK_EQUAL(0, TIM1->CCR4);		//The interrupt is moved to the start of period
+	CHECK_EQUAL(0, TIM1->CCMR2 & (TIM_CCMR1_OC2M | TIM_CCMR1_OC2PE));	//Timing mode without preload
+	TIM1->CNT = 0;
+	xSoftware.Compare_Event_Handler();
+	CHECK_EQUAL(1700, TIM1->CCR4);	//The edges are scaled to the new period
+	CHECK_EQUAL(GPIO_PIN_0 | GPIO_PIN_1, GPIOA->ODR & (GPIO_PIN_0 | GPIO_PIN_1));
+
+	CHECK(xPWM.Change_Frequency_Seamless(20000));
+	CHECK_EQUAL(0, TIM1->CCR4);
+	CHECK(xPWM.Start_Pulse_Train(TIM_CHANNEL_1, 10, 50) == false);	//The one pulse mode would stop the software channels
+}
+
+TEST(Software_PWM_Handler_Clears_Flag_After_Compare_Write)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	Software_PWM xSoftware(&xPWM, TIM_CHANNEL_4, xPins, 2);
+
+	xSoftware.Start_PWM(0, 50);
+	TIM1->SR.ulValue |= TIM_SR_CC4IF | TIM_SR_UIF;	//The hardware sets the flags
+	TIM1->CNT = 0;
+	xSoftware.Compare_Event_Handler();
+	CHECK_EQUAL(4250, TIM1->CCR4);
+	CHECK_EQUAL(TIM_SR_UIF, TIM1->SR & (TIM_SR_CC4IF | TIM_SR_UIF));
+}
+
+TEST(Software_PWM_Destructor_Releases_The_Timer)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	{
+		Software_PWM xSoftware(&xPWM, TIM_CHANNEL_4, xPins, 2);
+
+		xSoftware.Start_All_PWM(50);
+		CHECK_EQUAL(TIM_DIER_CC4IE, TIM1->DIER & TIM_DIER_CC4IE);
+	}
+	CHECK_EQUAL(0, TIM1->DIER & TIM_DIER_CC4IE);
+	xPWM.Start_All_PWM(50);
+	xPWM.Stop_All_PWM();
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_CEN);
+
+	Host_Reset_Counters();
+	Software_PWM xOutput(&xPWM, TIM_CHANNEL_1, xPins, 2);	//Channel 1 is a PWM output
+	CHECK_EQUAL(1, xHost_Counters.ulErrors);
+}
+/*****END OF FILE*****/
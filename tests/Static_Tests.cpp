@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    Static_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of Hardware_PWM_Static on the timer model. The registers
+  *          should match the registers of Hardware_PWM for the same channels.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Types ---------------------------------------------------------------------*/
+typedef Hardware_PWM_Static<Host_Timer<Host_TIM1>, ComplementMode, ComplementMode, SingleMode, Disable, false> Static_PWM_Type;
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Static_Matches_Hardware_PWM_Registers)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t CCER = 0;
+	uint32_t CCR[3] = {0};
+
+	xPWM.Start_All_PWM(30);
+	CCER = TIM1->CCER;
+	CCR[0] = TIM1->CCR1;
+	CCR[1] = TIM1->CCR2;
+	CCR[2] = TIM1->CCR3;
+	xPWM.Stop_All_PWM();
+	CHECK_EQUAL(0, TIM1->CCER);
+
+	Static_PWM_Type xStatic(xPWM.Get_Period());
+	xStatic.Start_All_PWM(30);
+	CHECK_EQUAL(CCER, TIM1->CCER);
+	CHECK_EQUAL(CCR[0], TIM1->CCR1);
+	CHECK_EQUAL(CCR[1], TIM1->CCR2);
+	CHECK_EQUAL(CCR[2], TIM1->CCR3);
+	CHECK_EQUAL(0, TIM1->CCR4);		//Channel 4 is disabled
+	CHECK((TIM1->BDTR & TIM_BDTR_MOE) != 0);
+	CHECK((TIM1->CR1 & TIM_CR1_CEN) != 0);
+}
+
+TEST(Static_Stops_Counter_With_Last_Channel)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	Static_PWM_Type xStatic(xPWM.Get_Period());
+
+	xStatic.Start_PWM(TIM_CHANNEL_1, 50);
+	xStatic.Start_PWM(TIM_CHANNEL_3, 50);
+	xStatic.Start_PWM(TIM_CHANNEL_4, 50);
+	CHECK_EQUAL(TIM_CCER_CC1E | TIM_CCER_CC1NE | (TIM_CCER_CC1E << TIM_CHANNEL_3), TIM1->CCER);
+	xStatic.Set_DutyCycle_Ticks<TIM_CHANNEL_3>(1000);
+	CHECK_EQUAL(1000, TIM1->CCR3);
+
+	xStatic.Stop_PWM(TIM_CHANNEL_1);
+	CHECK((TIM1->CR1 & TIM_CR1_CEN) != 0);
+	xStatic.Stop_PWM(TIM_CHANNEL_3);
+	CHECK_EQUAL(0, TIM1->CCER);
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_CEN);
+	CHECK_EQUAL(0, TIM1->BDTR & TIM_BDTR_MOE);
+}
+
+TEST(Static_Keeps_Main_Output_Off_After_Break)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	Static_PWM_Type xStatic(xPWM.Get_Period());
+
+	xStatic.Start_All_PWM(50);
+	Host_Break(TIM1);
+	xStatic.Stop_PWM(TIM_CHANNEL_1);
+	xStatic.Start_PWM(TIM_CHANNEL_1, 50);
+	CHECK_EQUAL(0, TIM1->BDTR & TIM_BDTR_MOE);
+	CHECK((TIM1->CCER & TIM_CCER_CC1E) != 0);
+}
+/*****END OF FILE*****/
@@ -0,0 +1,135 @@
+/**
+  ******************************************************************************
+  * @file    Stream_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of Capture Compare Register streaming by the update DMA
+  *          request and of its ring buffer handshake.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Variables -----------------------------------------------------------------*/
+static uint32_t ulFill_Calls;
+static uint32_t ulFill_Value;
+
+/* Functions -----------------------------------------------------------------*/
+static void Stream_Fill(uint32_t* _pulFrames, uint16_t _usFrameCount, void* _pvContext)
+{
+	(void)_pvContext;
+	ulFill_Calls++;
+	for (uint16_t n = 0; n < _usFrameCount; n++)
+	{
+		ulFill_Value++;
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			_pulFrames[(n * 4) + i] = ulFill_Value;
+		}
+	}
+}
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Stream_Ignores_Update_Interrupts)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t ulBuffer[8 * 4];
+
+	ulFill_Calls = 0;
+	ulFill_Value = 0;
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Start_Streaming(ulBuffer, 8, Stream_Fill, NULL));
+	CHECK_EQUAL(1, ulFill_Calls);
+	for (uint32_t n = 0; n < 64; n++)
+	{
+		CHECK(Host_Timer_Overflow(TIM1));
+		xPWM.Update_Event_Handler();	//The update interrupt of application does not touch the stream
+		CHECK_EQUAL(n + 1, TIM1->CCR1);	//The frames are played in order
+	}
+	CHECK_EQUAL(1 + 16, ulFill_Calls);	//One refill in each half transfer
+	CHECK_EQUAL(0, xPWM.Get_Stream_Underruns());
+	xPWM.Stop_Streaming();
+}
+
+TEST(Stream_Counts_Underruns_Of_Uncommitted_Halves)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t ulBuffer[8 * 4] = {0};
+
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Start_Streaming(ulBuffer, 8, NULL, NULL));
+	CHECK(xPWM.Stream_Get_Free_Half() == NULL);
+	for (uint8_t n = 0; n < 4; n++)
+	{
+		Host_Timer_Overflow(TIM1);
+	}
+	CHECK(xPWM.Stream_Get_Free_Half() == ulBuffer);
+	CHECK_EQUAL(0, xPWM.Get_Stream_Underruns());
+	for (uint8_t n = 0; n < 4; n++)
+	{
+		Host_Timer_Overflow(TIM1);
+	}
+	CHECK_EQUAL(1, xPWM.Get_Stream_Underruns());	//The first half is played again before it is committed
+
+	CHECK(xPWM.Stream_Commit_Half(xPWM.Stream_Get_Free_Half()));
+	CHECK(xPWM.Stream_Commit_Half(xPWM.Stream_Get_Free_Half()));
+	CHECK(xPWM.Stream_Get_Free_Half() == NULL);
+	for (uint8_t n = 0; n < 4; n++)
+	{
+		Host_Timer_Overflow(TIM1);
+	}
+	CHECK_EQUAL(1, xPWM.Get_Stream_Underruns());
+	CHECK_EQUAL(0, ulHost_PRIMASK);	//The critical section restores the interrupts
+	xPWM.Stop_Streaming();
+}
+
+TEST(Stream_Commit_Rejects_Foreign_Pointers)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t ulBuffer[8 * 4] = {0};
+	uint32_t ulOther[4 * 4] = {0};
+
+	CHECK(xPWM.Stream_Commit_Half(ulBuffer) == false);	//Not started
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Start_Streaming(ulBuffer, 8, NULL, NULL));
+	for (uint8_t n = 0; n < 8; n++)
+	{
+		Host_Timer_Overflow(TIM1);
+	}
+	CHECK(xPWM.Stream_Commit_Half(NULL) == false);
+	CHECK(xPWM.Stream_Commit_Half(ulOther) == false);
+	CHECK(xPWM.Stream_Commit_Half(ulBuffer + 4) == false);	//Inside the first half
+	CHECK(xPWM.Stream_Get_Free_Half() == ulBuffer);
+	CHECK(xPWM.Stream_Commit_Half(ulBuffer));
+	CHECK(xPWM.Stream_Commit_Half(ulBuffer + 16));
+	CHECK(xPWM.Stream_Get_Free_Half() == NULL);
+	xPWM.Stop_Streaming();
+}
+
+TEST(Start_Streaming_Rejects_Invalid_Buffers)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	uint32_t ulBuffer[8 * 4] = {0};
+
+	xPWM.Start_All_PWM(50);
+	CHECK(xPWM.Start_Streaming(ulBuffer, 7, NULL, NULL) == false);	//The halves would not be equal
+	CHECK(xPWM.Start_Streaming(ulBuffer, 0, NULL, NULL) == false);
+	CHECK(xPWM.Start_Streaming(NULL, 8, NULL, NULL) == false);
+	CHECK(xTimer.xDMA.xHost_Running == false);
+	CHECK_EQUAL(0, TIM1->DIER & TIM_DIER_UDE);
+
+	CHECK(xPWM.Start_Streaming(ulBuffer, 8, NULL, NULL));
+	CHECK(xPWM.Start_Streaming(ulBuffer, 8, NULL, NULL) == false);	//The DMA is used
+	xPWM.Stop_Streaming();
+	CHECK(xTimer.xDMA.xHost_Running == false);
+}
+/*****END OF FILE*****/
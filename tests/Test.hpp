@@ -0,0 +1,76 @@
+#pragma once
+/**
+  ******************************************************************************
+  * @file    Test.hpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Minimal test framework of host tests. Each TEST runs after
+  *          Host_Reset, so all timers, ports and counters start from reset.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEST_HPP
+#define TEST_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include "Hardware_PWM.hpp"
+#include <string.h>
+
+/* Types ---------------------------------------------------------------------*/
+typedef void (*Test_Function_Type)(void);
+
+struct Test_Case
+{
+	const char* pcName;
+	Test_Function_Type pxFunction;
+	Test_Case* pxNext;
+
+	Test_Case(const char* _pcName, Test_Function_Type _pxFunction);
+};
+
+/**
+  * @brief  Handles and configuration of a timer which is passed to Hardware_PWM. It should live as long as the object.
+  *			The default channels are complementary 1 and 2, single 3 and disabled 4.
+  */
+struct Test_Timer
+{
+	TIM_HandleTypeDef xHandle;
+	DMA_HandleTypeDef xDMA;
+	Hardware_PWM_Ver1::PWM_Channels xChannels;
+	Hardware_PWM_Ver1::TimerSpecs_Type xSpecs;
+
+	Test_Timer(TIM_TypeDef* _pxInstance, uint32_t _ulFrequency, uint32_t _ulDMA_Mode = DMA_CIRCULAR)
+	{
+		memset(&this->xDMA, 0, sizeof(this->xDMA));
+		this->xDMA.Init.Mode = _ulDMA_Mode;
+		Host_Timer_Handle_Init(&this->xHandle, _pxInstance, &this->xDMA);
+		this->xChannels.Channel1 = Hardware_PWM_Ver1::ComplementMode;
+		this->xChannels.Channel2 = Hardware_PWM_Ver1::ComplementMode;
+		this->xChannels.Channel3 = Hardware_PWM_Ver1::SingleMode;
+		this->xChannels.Channel4 = Hardware_PWM_Ver1::Disable;
+		this->xSpecs._ulFrequency = _ulFrequency;
+		this->xSpecs._xTimerIs32bit = (_pxInstance == TIM2);
+		this->xSpecs._ulDeadTime = 0;
+		this->xSpecs._ulCounterMode = TIM_COUNTERMODE_UP;
+		this->xSpecs._ulRepetitionCounter = 0;
+	}
+};
+
+/* Functions -----------------------------------------------------------------*/
+void Test_Check(bool _xPassed, const char* _pcExpression, const char* _pcFile, int _iLine);
+void Test_Check_Equal(uint64_t _ulExpected, uint64_t _ulActual, const char* _pcExpression, const char* _pcFile, int _iLine);
+
+/* Macros --------------------------------------------------------------------*/
+#define TEST(_Name)													\
+	static void _Name(void);										\
+	static Test_Case x##_Name##_Case(#_Name, _Name);				\
+	static void _Name(void)
+
+#define CHECK(_Condition)				Test_Check((_Condition), #_Condition, __FILE__, __LINE__)
+#define CHECK_EQUAL(_Expected, _Actual)	Test_Check_Equal((uint64_t)(_Expected), (uint64_t)(_Actual), #_Actual, __FILE__, __LINE__)
+
+#endif /* TEST_HPP */
+/*****END OF FILE*****/
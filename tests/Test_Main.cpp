@@ -0,0 +1,84 @@
+/**
+  ******************************************************************************
+  * @file    Test_Main.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Runner of host tests. It returns the number of failed tests.
+  *          Usage: Hardware_PWM_Tests_LL [test name]
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+#include <stdio.h>
+#include <inttypes.h>
+
+/* Variables -----------------------------------------------------------------*/
+static Test_Case* pxFirst_Case = NULL;
+static Test_Case* pxLast_Case = NULL;
+static uint32_t ulFailed_Checks = 0;
+
+/* Functions -----------------------------------------------------------------*/
+Test_Case::Test_Case(const char* _pcName, Test_Function_Type _pxFunction)
+{
+	this->pcName = _pcName;
+	this->pxFunction = _pxFunction;
+	this->pxNext = NULL;
+	if (pxLast_Case == NULL)
+	{
+		pxFirst_Case = this;
+	}
+	else
+	{
+		pxLast_Case->pxNext = this;
+	}
+	pxLast_Case = this;
+}
+
+void Test_Check(bool _xPassed, const char* _pcExpression, const char* _pcFile, int _iLine)
+{
+	if (_xPassed == false)
+	{
+		printf("  %s:%d: CHECK(%s) failed\n", _pcFile, _iLine, _pcExpression);
+		ulFailed_Checks++;
+	}
+}
+
+void Test_Check_Equal(uint64_t _ulExpected, uint64_t _ulActual, const char* _pcExpression, const char* _pcFile, int _iLine)
+{
+	if (_ulExpected != _ulActual)
+	{
+		printf("  %s:%d: %s is %" PRIu64 ", expected %" PRIu64 "\n", _pcFile, _iLine, _pcExpression, _ulActual, _ulExpected);
+		ulFailed_Checks++;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t Tests = 0;
+	uint32_t Failed = 0;
+
+	for (Test_Case* Case = pxFirst_Case; Case != NULL; Case = Case->pxNext)
+	{
+		uint32_t Checks = ulFailed_Checks;
+
+		if ((argc > 1) && (strcmp(argv[1], Case->pcName) != 0))
+		{
+			continue;
+		}
+		Host_Reset();
+		Case->pxFunction();
+		Tests++;
+		if (ulFailed_Checks != Checks)
+		{
+			printf("FAILED %s\n", Case->pcName);
+			Failed++;
+		}
+	}
+
+	printf("%" PRIu32 " tests, %" PRIu32 " failed\n", Tests, Failed);
+	return (int)Failed;
+}
+/*****END OF FILE*****/
@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file    Update_Tests.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Tests of held update events (Begin_Update/End_Update) and of the
+  *          functions which change registers in the update event.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Test.hpp"
+
+using namespace Hardware_PWM_Ver1;
+
+/* Tests ---------------------------------------------------------------------*/
+TEST(Update_Brackets_Can_Be_Nested)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	Host_Timer_Overflow(TIM1);
+	xPWM.Begin_Update();
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_1, 1000);
+	xPWM.Begin_Update();
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_2, 2000);
+	xPWM.End_Update();
+	CHECK_EQUAL(TIM_CR1_UDIS, TIM1->CR1 & TIM_CR1_UDIS);	//The inner pair does not release the update event
+	CHECK(Host_Timer_Overflow(TIM1) == false);
+	CHECK(Host_Active_CCR(TIM1, 0) != 1000);
+
+	xPWM.End_Update();
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_UDIS);
+	CHECK(Host_Timer_Overflow(TIM1));
+	CHECK_EQUAL(1000, Host_Active_CCR(TIM1, 0));
+	CHECK_EQUAL(2000, Host_Active_CCR(TIM1, 1));
+}
+
+TEST(Update_Bracket_Holds_Seamless_Frequency_Change)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.Start_All_PWM(50);
+	xPWM.Begin_Update();
+	xPWM.Change_Frequency_Seamless(25000);	//It has its own pair inside
+	xPWM.Set_DutyCycle_Ticks(TIM_CHANNEL_3, 100);
+	CHECK_EQUAL(TIM_CR1_UDIS, TIM1->CR1 & TIM_CR1_UDIS);
+	CHECK(Host_Timer_Overflow(TIM1) == false);
+	CHECK_EQUAL(8499, Host_Active_ARR(TIM1));
+	xPWM.End_Update();
+	CHECK(Host_Timer_Overflow(TIM1));
+	CHECK_EQUAL(6799, Host_Active_ARR(TIM1));
+	CHECK_EQUAL(100, Host_Active_CCR(TIM1, 2));
+}
+
+TEST(Unpaired_End_Update_Is_Ignored)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+
+	xPWM.End_Update();
+	xPWM.Begin_Update();
+	CHECK_EQUAL(TIM_CR1_UDIS, TIM1->CR1 & TIM_CR1_UDIS);
+	xPWM.End_Update();
+	CHECK_EQUAL(0, TIM1->CR1 & TIM_CR1_UDIS);
+}
+
+TEST(Update_Rate_Is_Limited_By_Repetition_Counter_Size)
+{
+	Test_Timer xTimer(TIM1, 20000);
+	Test_Timer xSmall_Timer(TIM15, 20000);
+	xSmall_Timer.xChannels.Channel3 = Disable;
+	Hardware_PWM xPWM(&xTimer.xHandle, &xTimer.xChannels, &xTimer.xSpecs);
+	Hardware_PWM xSmall(&xSmall_Timer.xHandle, &xSmall_Timer.xChannels, &xSmall_Timer.xSpecs);
+
+	xPWM.Set_Update_Rate(1000);
+	xSmall.Set_Update_Rate(1000);
+	CHECK_EQUAL(999, TIM1->RCR);
+	CHECK_EQUAL(0xFF, TIM15->RCR);		//TIM15 has an 8 bit repetition counter
+	CHECK_EQUAL(0xFF, xSmall_Timer.xSpecs._ulRepetitionCounter);
+	xSmall.Set_Update_Rate(100);
+	CHECK_EQUAL(99, TIM15->RCR);
+}
+/*****END OF FILE*****/
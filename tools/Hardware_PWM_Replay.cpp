@@ -0,0 +1,405 @@
+/**
+  ******************************************************************************
+  * @file    Hardware_PWM_Replay.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Host command replay of Hardware_PWM. Each line of the command log
+  *          is one command, and '#' starts a comment:
+  *            init <Hz> <deadtime nS> <mode1> <mode2> <mode3> <mode4> [center]
+  *                 The modes are D (Disable), S (SingleMode), C (ComplementMode)
+  *            start <channel> <duty %>      stop <channel>
+  *            start_all <duty %>            stop_all
+  *            duty <channel> <duty %>       run <periods>
+  *            frequency <Hz>                seamless <Hz>
+  *          The channels are 1 to 4. A command is applied between two periods,
+  *          so the changed preload registers are used from the next period.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Hardware_PWM_Replay.hpp"
+#include <algorithm>
+#include <inttypes.h>
+#include <string.h>
+#include <vector>
+
+using namespace Hardware_PWM_Ver1;
+
+/* Types ---------------------------------------------------------------------*/
+typedef struct
+{
+	uint64_t ulTime;	//The edge time according to timer clocks
+	uint8_t ucSignal;	//0 to 7 for CH1, CH1N, ..., CH4N
+	uint8_t ucLevel;
+}Replay_Edge_Type;
+
+typedef struct
+{
+	TIM_HandleTypeDef xHandle;
+	DMA_HandleTypeDef xDMA;
+	PWM_Channels xChannels;
+	TimerSpecs_Type xSpecs;
+	Hardware_PWM* pxPWM;
+	FILE* pxOutput;
+	Replay_FormatType xFormat;
+	Replay_Summary_Type* pxSummary;
+	uint32_t ulClock;				//The timer clock according to Hz
+	uint8_t ucLevel[8];				//The output level of each signal
+	uint64_t ulFall[8];				//The time of last falling edge of each signal
+	bool xFallen[8];				//The signal has a falling edge
+	uint64_t ulWritten_Time;		//The last time which is written to the VCD file
+	std::vector<Replay_Edge_Type> xEdges;
+}Replay_State_Type;
+
+/* Variables -----------------------------------------------------------------*/
+static const char* const pcSignal_Names[8] = {"CH1", "CH1N", "CH2", "CH2N", "CH3", "CH3N", "CH4", "CH4N"};
+
+/* Functions -----------------------------------------------------------------*/
+/**
+  * @brief  This function checks a signal is used by the channel modes
+  * @param  _pxState: The replay state
+  *			_ucSignal: 0 to 7 for CH1, CH1N, ..., CH4N
+  * @retval true if the signal is an output
+  */
+static bool Replay_Signal_Is_Used(Replay_State_Type* _pxState, uint8_t _ucSignal)
+{
+	const Channel_ModeType Modes[4] = {_pxState->xChannels.Channel1, _pxState->xChannels.Channel2,
+									   _pxState->xChannels.Channel3, _pxState->xChannels.Channel4};
+	Channel_ModeType Mode = Modes[_ucSignal >> 1];
+
+	return ((_ucSignal & 1) == 0) ? (Mode != Disable) : (Mode == ComplementMode);
+}
+
+/**
+  * @brief  This function converts a time from timer clocks to pS without overflow
+  * @param  _ulClocks: The time according to timer clocks
+  *			_ulClock: The timer clock according to Hz
+  * @retval The time according to pS
+  */
+static uint64_t Replay_To_Picoseconds(uint64_t _ulClocks, uint32_t _ulClock)
+{
+	uint64_t Seconds = _ulClocks / _ulClock;
+	uint64_t Rest = (_ulClocks % _ulClock) * 1000000ULL;	//According to uS * clock
+
+	return (Seconds * 1000000000000ULL) + ((Rest / _ulClock) * 1000000ULL) + (((Rest % _ulClock) * 1000000ULL) / _ulClock);
+}
+
+/**
+  * @brief  This function writes the header of output file and the levels at time 0
+  * @param  _pxState: The replay state
+  * @retval None
+  */
+static void Replay_Write_Header(Replay_State_Type* _pxState)
+{
+	if (_pxState->xFormat == Replay_EdgeList)
+	{
+		fprintf(_pxState->pxOutput, "# clock %" PRIu32 " Hz, time according to timer clocks\n", _pxState->ulClock);
+	}
+	else if (_pxState->xFormat == Replay_VCD)
+	{
+		fprintf(_pxState->pxOutput, "$timescale 1 ps $end\n$scope module Hardware_PWM $end\n");
+		for (uint8_t i = 0; i < 8; i++)
+		{
+			if (Replay_Signal_Is_Used(_pxState, i))
+			{
+				fprintf(_pxState->pxOutput, "$var wire 1 %c %s $end\n", 'a' + i, pcSignal_Names[i]);
+			}
+		}
+		fprintf(_pxState->pxOutput, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+		for (uint8_t i = 0; i < 8; i++)
+		{
+			if (Replay_Signal_Is_Used(_pxState, i))
+			{
+				fprintf(_pxState->pxOutput, "0%c\n", 'a' + i);
+			}
+		}
+		fprintf(_pxState->pxOutput, "$end\n");
+	}
+}
+
+/**
+  * @brief  This function applies an edge to the signal levels, checks the outputs of its channel and writes it
+  * @param  _pxState: The replay state
+  *			_pxEdge: The edge
+  * @retval None
+  */
+static void Replay_Apply_Edge(Replay_State_Type* _pxState, const Replay_Edge_Type* _pxEdge)
+{
+	uint8_t Partner = _pxEdge->ucSignal ^ 1;	//CHx and CHxN of the same channel
+	Replay_Summary_Type* Summary = _pxState->pxSummary;
+
+	if (_pxState->ucLevel[_pxEdge->ucSignal] == _pxEdge->ucLevel)
+	{
+		return;
+	}
+	_pxState->ucLevel[_pxEdge->ucSignal] = _pxEdge->ucLevel;
+	Summary->ulEdges++;
+
+	if (_pxEdge->ucLevel == 0)
+	{
+		_pxState->ulFall[_pxEdge->ucSignal] = _pxEdge->ulTime;
+		_pxState->xFallen[_pxEdge->ucSignal] = true;
+	}
+	else if (Replay_Signal_Is_Used(_pxState, (uint8_t)(_pxEdge->ucSignal | 1)))	//A complementary channel
+	{
+		if (_pxState->ucLevel[Partner] != 0)
+		{
+			Summary->ulOverlaps++;
+		}
+		else if ((_pxState->xFallen[Partner] == true) && ((_pxEdge->ulTime - _pxState->ulFall[Partner]) < Summary->ulMin_Gap))
+		{
+			Summary->ulMin_Gap = _pxEdge->ulTime - _pxState->ulFall[Partner];
+		}
+	}
+
+	if (_pxState->xFormat == Replay_EdgeList)
+	{
+		fprintf(_pxState->pxOutput, "%" PRIu64 " %s %u\n", _pxEdge->ulTime, pcSignal_Names[_pxEdge->ucSignal], _pxEdge->ucLevel);
+	}
+	else if (_pxState->xFormat == Replay_VCD)
+	{
+		if (_pxEdge->ulTime != _pxState->ulWritten_Time)	//The header writes time 0
+		{
+			fprintf(_pxState->pxOutput, "#%" PRIu64 "\n", Replay_To_Picoseconds(_pxEdge->ulTime, _pxState->ulClock));
+			_pxState->ulWritten_Time = _pxEdge->ulTime;
+		}
+		fprintf(_pxState->pxOutput, "%u%c\n", _pxEdge->ucLevel, 'a' + _pxEdge->ucSignal);
+	}
+}
+
+/**
+  * @brief  This function simulates PWM periods. The edges of each period are taken from Get_Channel_Edges at the
+  *			start of period, and they are applied in time order. The falling edges are applied before the rising edges
+  *			of the same time.
+  * @param  _pxState: The replay state
+  *			_ulPeriods: The number of periods
+  * @retval None
+  */
+static void Replay_Run_Periods(Replay_State_Type* _pxState, uint64_t _ulPeriods)
+{
+	Channel_Edges_Type Edges;
+	Replay_Summary_Type* Summary = _pxState->pxSummary;
+
+	for (uint64_t Count = 0; Count < _ulPeriods; Count++)
+	{
+		uint64_t Period = 0;
+
+		_pxState->xEdges.clear();
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			if (_pxState->pxPWM->Get_Channel_Edges((uint8_t)(i << 2), &Edges) == false)
+			{
+				continue;
+			}
+			Period = Edges.ulPeriod;
+			for (uint8_t j = 0; j < 2; j++)
+			{
+				const Output_Edge_Type* Output = (j == 0) ? &Edges.xOutput : &Edges.xComplement;
+				uint8_t Signal = (uint8_t)((i * 2) + j);
+				uint64_t Fall = 0;
+
+				if ((Replay_Signal_Is_Used(_pxState, Signal) == false) || (Period == 0))
+				{
+					continue;
+				}
+				_pxState->xEdges.push_back({Summary->ulTime, Signal, (uint8_t)((((Period - Output->ulRise) % Period) < Output->ulWidth) ? 1 : 0)});	//The level at the start of period
+				if ((Output->ulWidth != 0) && (Output->ulWidth < Period))
+				{
+					Fall = (Output->ulRise + Output->ulWidth) % Period;
+					if (Output->ulRise != 0)
+					{
+						_pxState->xEdges.push_back({Summary->ulTime + Output->ulRise, Signal, 1});
+					}
+					if (Fall != 0)
+					{
+						_pxState->xEdges.push_back({Summary->ulTime + Fall, Signal, 0});
+					}
+				}
+			}
+		}
+		if (Period == 0)	//No channel is used
+		{
+			return;
+		}
+
+		std::sort(_pxState->xEdges.begin(), _pxState->xEdges.end(), [](const Replay_Edge_Type& _xA, const Replay_Edge_Type& _xB)
+		{
+			return (_xA.ulTime != _xB.ulTime) ? (_xA.ulTime < _xB.ulTime) : (_xA.ucLevel < _xB.ucLevel);
+		});
+		for (size_t i = 0; i < _pxState->xEdges.size(); i++)
+		{
+			Replay_Apply_Edge(_pxState, &_pxState->xEdges[i]);
+		}
+		Summary->ulTime += Period;
+		Summary->ulPeriods++;
+	}
+}
+
+/**
+  * @brief  This function converts a mode letter of init command
+  * @param  _cMode: D, S or C
+  *			_pxMode: Saves the mode
+  * @retval false if the letter is not known
+  */
+static bool Replay_Parse_Mode(char _cMode, Channel_ModeType* _pxMode)
+{
+	switch (_cMode)
+	{
+	case 'D':
+		*_pxMode = Disable;
+		return true;
+	case 'S':
+		*_pxMode = SingleMode;
+		return true;
+	case 'C':
+		*_pxMode = ComplementMode;
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+  * @brief  This function creates the PWM object of init command on TIM1 of the timer model
+  * @param  _pxState: The replay state
+  *			_pcArguments: The arguments of init command
+  * @retval false if the arguments are not valid or the object is created before
+  */
+static bool Replay_Init(Replay_State_Type* _pxState, const char* _pcArguments)
+{
+	uint32_t Frequency = 0;
+	uint32_t DeadTime = 0;
+	char Modes[4] = {0};
+	char Counter[16] = {0};
+	int Count = sscanf(_pcArguments, "%" SCNu32 " %" SCNu32 " %c %c %c %c %15s", &Frequency, &DeadTime, &Modes[0], &Modes[1], &Modes[2], &Modes[3], Counter);
+
+	if ((_pxState->pxPWM != NULL) || (Count < 6) || (Frequency == 0) ||
+		!Replay_Parse_Mode(Modes[0], &_pxState->xChannels.Channel1) || !Replay_Parse_Mode(Modes[1], &_pxState->xChannels.Channel2) ||
+		!Replay_Parse_Mode(Modes[2], &_pxState->xChannels.Channel3) || !Replay_Parse_Mode(Modes[3], &_pxState->xChannels.Channel4) ||
+		((Count == 7) && (strcmp(Counter, "center") != 0)))
+	{
+		return false;
+	}
+
+	Host_Reset();
+	memset(&_pxState->xDMA, 0, sizeof(_pxState->xDMA));
+	_pxState->xDMA.Init.Mode = DMA_CIRCULAR;
+	Host_Timer_Handle_Init(&_pxState->xHandle, TIM1, &_pxState->xDMA);
+	_pxState->xSpecs._ulFrequency = Frequency;
+	_pxState->xSpecs._xTimerIs32bit = false;
+	_pxState->xSpecs._ulDeadTime = DeadTime;
+	_pxState->xSpecs._ulCounterMode = (Count == 7) ? TIM_COUNTERMODE_CENTERALIGNED1 : TIM_COUNTERMODE_UP;
+	_pxState->xSpecs._ulRepetitionCounter = 0;
+	_pxState->pxPWM = new Hardware_PWM(&_pxState->xHandle, &_pxState->xChannels, &_pxState->xSpecs);
+	_pxState->ulClock = HAL_RCC_GetPCLK2Freq();
+	Replay_Write_Header(_pxState);
+	return true;
+}
+
+/**
+  * @brief  This function applies one command line
+  * @param  _pxState: The replay state
+  *			_pcLine: The command line
+  * @retval false if the command is not known, its arguments are not valid or Hardware_PWM refuses it
+  */
+static bool Replay_Command(Replay_State_Type* _pxState, const char* _pcLine)
+{
+	Hardware_PWM* PWM = _pxState->pxPWM;
+	char Command[16] = {0};
+	int Length = 0;
+	uint32_t Channel = 0;
+	uint64_t Periods = 0;
+	uint32_t Frequency = 0;
+	double DutyCycle = 0;
+
+	if ((sscanf(_pcLine, " %15s%n", Command, &Length) != 1) || (Command[0] == '#'))	//An empty line or a comment
+	{
+		return true;
+	}
+	_pcLine += Length;
+	if (strcmp(Command, "init") == 0)
+	{
+		return Replay_Init(_pxState, _pcLine);
+	}
+	if (PWM == NULL)	//The other commands need the object
+	{
+		return false;
+	}
+
+	if ((strcmp(Command, "start") == 0) && (sscanf(_pcLine, "%" SCNu32 " %lf", &Channel, &DutyCycle) == 2) && (Channel >= 1) && (Channel <= 4))
+	{
+		PWM->Start_PWM((uint8_t)((Channel - 1) << 2), DutyCycle);
+	}
+	else if ((strcmp(Command, "stop") == 0) && (sscanf(_pcLine, "%" SCNu32, &Channel) == 1) && (Channel >= 1) && (Channel <= 4))
+	{
+		PWM->Stop_PWM((uint8_t)((Channel - 1) << 2));
+	}
+	else if ((strcmp(Command, "duty") == 0) && (sscanf(_pcLine, "%" SCNu32 " %lf", &Channel, &DutyCycle) == 2) && (Channel >= 1) && (Channel <= 4))
+	{
+		PWM->Change_DutyCycle((uint8_t)((Channel - 1) << 2), DutyCycle);
+	}
+	else if ((strcmp(Command, "start_all") == 0) && (sscanf(_pcLine, "%lf", &DutyCycle) == 1))
+	{
+		PWM->Start_All_PWM(DutyCycle);
+	}
+	else if (strcmp(Command, "stop_all") == 0)
+	{
+		PWM->Stop_All_PWM();
+	}
+	else if ((strcmp(Command, "frequency") == 0) && (sscanf(_pcLine, "%" SCNu32, &Frequency) == 1))
+	{
+		return PWM->Change_Frequency(Frequency);
+	}
+	else if ((strcmp(Command, "seamless") == 0) && (sscanf(_pcLine, "%" SCNu32, &Frequency) == 1))
+	{
+		return PWM->Change_Frequency_Seamless(Frequency);
+	}
+	else if ((strcmp(Command, "run") == 0) && (sscanf(_pcLine, "%" SCNu64, &Periods) == 1))
+	{
+		Replay_Run_Periods(_pxState, Periods);
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+/**
+  * @brief  This function replays a command log and writes the output edges
+  * @param  _pxInput: The command log
+  *			_pxOutput: The output file. It is not used by Replay_None
+  *			_xFormat: The format of output file
+  *			_pxSummary: Saves the summary of simulation
+  * @retval true if all command lines are applied
+  */
+bool Replay_Run(FILE* _pxInput, FILE* _pxOutput, Replay_FormatType _xFormat, Replay_Summary_Type* _pxSummary)
+{
+	Replay_State_Type* State = new Replay_State_Type();
+	char Line[256];
+	uint32_t Line_Number = 0;
+
+	memset(_pxSummary, 0, sizeof(*_pxSummary));
+	_pxSummary->ulMin_Gap = UINT64_MAX;
+	State->pxPWM = NULL;
+	State->pxOutput = _pxOutput;
+	State->xFormat = _xFormat;
+	State->pxSummary = _pxSummary;
+
+	while (fgets(Line, sizeof(Line), _pxInput) != NULL)
+	{
+		Line_Number++;
+		if (Replay_Command(State, Line) == false)
+		{
+			fprintf(stderr, "Line %" PRIu32 " is not applied: %s", Line_Number, Line);
+			_pxSummary->ulLine_Errors++;
+		}
+	}
+
+	delete State->pxPWM;
+	delete State;
+	return (_pxSummary->ulLine_Errors == 0);
+}
+/*****END OF FILE*****/
@@ -0,0 +1,45 @@
+#pragma once
+/**
+  ******************************************************************************
+  * @file    Hardware_PWM_Replay.hpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Header file of the host command replay. A command log is applied
+  *          to a Hardware_PWM object on the timer model and the output edges
+  *          of each PWM period are taken from Get_Channel_Edges.
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef Hardware_PWM_Replay_HPP
+#define Hardware_PWM_Replay_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include "Hardware_PWM.hpp"
+#include <stdio.h>
+
+/* Types ---------------------------------------------------------------------*/
+typedef enum
+{
+	Replay_EdgeList = 0,	//One line for each edge: time (timer clocks), signal, level
+	Replay_VCD,				//Value Change Dump file for waveform viewers. The times are rounded to pS
+	Replay_None				//Only the summary is made, for long simulations
+}Replay_FormatType;
+
+typedef struct
+{
+	uint64_t ulPeriods;		//The number of simulated PWM periods
+	uint64_t ulTime;		//The simulated time according to timer clocks
+	uint64_t ulEdges;		//The number of output edges
+	uint64_t ulOverlaps;	//The number of times which CHx and CHxN are active together
+	uint64_t ulMin_Gap;		//The shortest time between the outputs of a complementary channel according to timer clocks
+	uint32_t ulLine_Errors;	//The number of command lines which are not known or are refused
+}Replay_Summary_Type;
+
+/* Functions -----------------------------------------------------------------*/
+bool Replay_Run(FILE* _pxInput, FILE* _pxOutput, Replay_FormatType _xFormat, Replay_Summary_Type* _pxSummary);
+
+#endif /* Hardware_PWM_Replay_HPP */
+/*****END OF FILE*****/
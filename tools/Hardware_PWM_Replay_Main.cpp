@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    Hardware_PWM_Replay_Main.cpp
+  * @author  Hadi Dastour
+  *	@version 1.0.0
+  * @brief   Host tool which replays a command log on Hardware_PWM and writes
+  *          the output edges as an edge list or a VCD file. The summary is
+  *          printed to stderr, and the exit code is not 0 if a command is not
+  *          applied or CHx and CHxN of a channel are active together.
+  *          Usage: Hardware_PWM_Replay_LL <command log> [-edges | -vcd | -none] [output file]
+  * @support Email: Hadi.Dastoor@gmail.com
+  *			 Github: https://github.com/H-Dastour
+  ******************************************************************************
+**/
+
+/* Includes ------------------------------------------------------------------*/
+#include "Hardware_PWM_Replay.hpp"
+#include <inttypes.h>
+#include <string.h>
+
+/* Functions -----------------------------------------------------------------*/
+int main(int argc, char** argv)
+{
+	Replay_FormatType Format = Replay_EdgeList;
+	Replay_Summary_Type Summary;
+	FILE* Input = NULL;
+	FILE* Output = stdout;
+	bool Applied = false;
+
+	if ((argc < 2) || (argc > 4))
+	{
+		fprintf(stderr, "Usage: %s <command log> [-edges | -vcd | -none] [output file]\n", argv[0]);
+		return 2;
+	}
+	if (argc > 2)
+	{
+		if (strcmp(argv[2], "-vcd") == 0)
+		{
+			Format = Replay_VCD;
+		}
+		else if (strcmp(argv[2], "-none") == 0)
+		{
+			Format = Replay_None;
+		}
+		else if (strcmp(argv[2], "-edges") != 0)
+		{
+			fprintf(stderr, "Unknown format %s\n", argv[2]);
+			return 2;
+		}
+	}
+
+	Input = fopen(argv[1], "r");
+	if ((argc > 3) && (Input != NULL))
+	{
+		Output = fopen(argv[3], "w");
+	}
+	if ((Input == NULL) || (Output == NULL))
+	{
+		fprintf(stderr, "The file can not be opened\n");
+		return 2;
+	}
+
+	Applied = Replay_Run(Input, Output, Format, &Summary);
+	fclose(Input);
+	if (Output != stdout)
+	{
+		fclose(Output);
+	}
+
+	fprintf(stderr, "Periods: %" PRIu64 "\nTime: %" PRIu64 " timer clocks\nEdges: %" PRIu64 "\nOverlaps: %" PRIu64 "\n",
+			Summary.ulPeriods, Summary.ulTime, Summary.ulEdges, Summary.ulOverlaps);
+	if (Summary.ulMin_Gap != UINT64_MAX)
+	{
+		fprintf(stderr, "Shortest gap of complementary outputs: %" PRIu64 " timer clocks\n", Summary.ulMin_Gap);
+	}
+	fprintf(stderr, "Rejected lines: %" PRIu32 "\n", Summary.ulLine_Errors);
+	return ((Applied == true) && (Summary.ulOverlaps == 0)) ? 0 : 1;
+}
+/*****END OF FILE*****/